@@ -40,6 +40,11 @@ public:
   /// initialize references after read
   virtual bool setReferences(const ICollectionProvider* collectionProvider) = 0;
 
+  /// create all the objects of a collection that has been read, which otherwise
+  /// only happens on first access
+  virtual void materialize() const {
+  }
+
   /// set collection ID
   virtual void setID(uint32_t id) = 0;
 
@@ -49,6 +54,13 @@ public:
   /// Get the collection buffers for this collection
   virtual podio::CollectionWriteBuffers getBuffers() = 0;
 
+  /// release the (emptied) I/O buffers of this collection for re-use. Afterwards
+  /// the collection is empty and must not be used anymore, except for
+  /// destroying it. Returns empty buffers if the collection cannot release them
+  virtual podio::CollectionReadBuffers releaseBuffers() {
+    return {};
+  }
+
   /// check for validity of the container after read
   virtual bool isValid() const = 0;
 
@@ -0,0 +1,64 @@
+#ifndef PODIO_COLLECTIONBUFFERPOOL_H
+#define PODIO_COLLECTIONBUFFERPOOL_H
+
+#include "podio/CollectionBuffers.h"
+#include "podio/SchemaEvolution.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace podio {
+
+/// A pool of collection I/O buffers that can be re-used for reading.
+///
+/// Readers can hand out buffers from the pool instead of creating new ones for
+/// every entry. Once a Frame that has been created from these buffers is
+/// destroyed, the (emptied) buffers of its collections are put back into the
+/// pool, such that the vectors in them keep their capacity and the next entry
+/// can be read without allocating them anew. The pool is shared between the
+/// reader and all the raw Frame data it creates and can be used from multiple
+/// threads.
+class CollectionBufferPool {
+public:
+  CollectionBufferPool() = default;
+  /// Deletes all buffers that are still in the pool
+  ~CollectionBufferPool();
+
+  CollectionBufferPool(const CollectionBufferPool&) = delete;
+  CollectionBufferPool& operator=(const CollectionBufferPool&) = delete;
+  CollectionBufferPool(CollectionBufferPool&&) = delete;
+  CollectionBufferPool& operator=(CollectionBufferPool&&) = delete;
+
+  /// Get buffers for the collection with the given name from the pool.
+  ///
+  /// @param name          The name of the collection
+  /// @param type          The collection type the buffers are needed for
+  /// @param schemaVersion The schema version the buffers are needed for
+  /// @param isSubsetColl  Whether the buffers are for a subset collection
+  ///
+  /// @returns Buffers if there are matching ones in the pool, otherwise an
+  ///          empty optional
+  std::optional<podio::CollectionReadBuffers> take(const std::string& name, std::string_view type,
+                                                   SchemaVersionT schemaVersion, bool isSubsetColl);
+
+  /// Put the buffers for the collection with the given name into the pool.
+  /// They have to have all the type dependent functions set. Their contents do
+  /// not matter, since they will be overwritten when they are read into again
+  void put(const std::string& name, podio::CollectionReadBuffers buffers);
+
+  /// The number of buffers that are currently in the pool
+  size_t size() const;
+
+private:
+  mutable std::mutex m_mutex{};
+  std::unordered_map<std::string, std::vector<podio::CollectionReadBuffers>> m_buffers{};
+};
+
+} // namespace podio
+
+#endif // PODIO_COLLECTIONBUFFERPOOL_H
@@ -0,0 +1,57 @@
+#ifndef PODIO_COLLECTIONHANDLE_H
+#define PODIO_COLLECTIONHANDLE_H
+
+#include "podio/CollectionLayout.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace podio {
+
+class Frame;
+
+/// A typed token for quickly getting a collection from a Frame.
+///
+/// A handle is obtained via Frame::getHandle and remembers the slot of the
+/// collection in the CollectionLayout of that Frame. Getting the collection via
+/// the handle from any Frame with the same layout (e.g. all Frames of the same
+/// category read by the same reader) is then a simple index lookup, instead of
+/// a lookup by name. For all other Frames it falls back to the lookup by name.
+///
+/// Handles are immutable and can be shared between threads.
+///
+/// @tparam CollT The type of the collection
+template <typename CollT>
+class CollectionHandle {
+  friend class podio::Frame;
+
+public:
+  /// A handle that is not bound to any layout, i.e. getting a collection with
+  /// it always uses the lookup by name
+  explicit CollectionHandle(std::string name) : m_name(std::move(name)) {
+  }
+
+  /// The name of the collection
+  const std::string& name() const {
+    return m_name;
+  }
+
+  /// Whether this handle is bound to a layout, i.e. allows for fast lookup
+  bool isBound() const {
+    return m_layout != nullptr;
+  }
+
+private:
+  CollectionHandle(std::string name, std::shared_ptr<const podio::CollectionLayout> layout, size_t slot) :
+      m_name(std::move(name)), m_layout(std::move(layout)), m_slot(slot) {
+  }
+
+  std::string m_name{};                                      ///< The name of the collection
+  std::shared_ptr<const podio::CollectionLayout> m_layout{}; ///< The layout in which the slot is valid
+  size_t m_slot{0};                                          ///< The slot of the collection in the layout
+};
+
+} // namespace podio
+
+#endif // PODIO_COLLECTIONHANDLE_H
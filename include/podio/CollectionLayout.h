@@ -0,0 +1,56 @@
+#ifndef PODIO_COLLECTIONLAYOUT_H
+#define PODIO_COLLECTIONLAYOUT_H
+
+#include "podio/CollectionIDTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace podio {
+
+/// The layout of the collections of all Frames that share the same collection
+/// ID table, e.g. all Frames of one category that are read from the same file.
+///
+/// It assigns a fixed, dense slot to every collection, through which the
+/// collection can be accessed in each of these Frames without having to look
+/// it up by name. A layout is immutable after construction and can therefore
+/// be shared between Frames (and threads) freely.
+class CollectionLayout {
+public:
+  CollectionLayout() = default;
+
+  /// Create the layout for all collections in the collection ID table
+  explicit CollectionLayout(const podio::CollectionIDTable& idTable);
+
+  /// Get the slot of the collection with the given ID
+  std::optional<size_t> slot(uint32_t collectionID) const;
+
+  /// Get the slot of the collection with the given name
+  std::optional<size_t> slot(const std::string& name) const;
+
+  /// The number of slots
+  size_t size() const {
+    return m_collectionIDs.size();
+  }
+
+  /// The ID of the collection in the given slot
+  uint32_t collectionID(size_t slot) const {
+    return m_collectionIDs[slot];
+  }
+
+  /// The name of the collection in the given slot
+  const std::string& name(size_t slot) const {
+    return m_names[slot];
+  }
+
+private:
+  std::vector<uint32_t> m_collectionIDs{}; ///< The collection IDs sorted in ascending order
+  std::vector<std::string> m_names{};      ///< The names of the collections in the same order as the IDs
+};
+
+} // namespace podio
+
+#endif // PODIO_COLLECTIONLAYOUT_H
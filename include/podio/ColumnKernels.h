@@ -0,0 +1,93 @@
+#ifndef PODIO_COLUMNKERNELS_H
+#define PODIO_COLUMNKERNELS_H
+
+#include "podio/ColumnView.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace podio {
+
+/// The type that is used to sum up the values of a column of type T. Integer
+/// types are summed up with 64 bits to avoid (early) overflows
+template <typename T>
+using ColumnSumType = std::conditional_t<std::is_floating_point_v<T>, T,
+                                         std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+namespace detail {
+  /// Call func for every element of the view, stepping directly through memory
+  /// for strided views and going through the objects otherwise
+  template <typename T, typename Func>
+  void forEachElement(const ColumnView<T>& view, Func&& func) {
+    const auto size = view.size();
+    if (view.isStrided()) {
+      using BytePtr = std::conditional_t<std::is_const_v<T>, const std::byte*, std::byte*>;
+      auto* first = reinterpret_cast<BytePtr>(view.data());
+      const auto stride = view.stride();
+      for (size_t i = 0; i < size; ++i) {
+        func(*reinterpret_cast<T*>(first + i * stride));
+      }
+    } else {
+      for (auto& value : view) {
+        func(value);
+      }
+    }
+  }
+
+  /// Reduce all elements of the view with the passed binary operation
+  template <typename AccT, typename T, typename Op>
+  AccT reduce(const ColumnView<const T>& view, AccT init, Op op) {
+    auto result = init;
+    forEachElement(view, [&result, &op](const T& value) { result = op(result, static_cast<AccT>(value)); });
+    return result;
+  }
+} // namespace detail
+
+/// The sum of all values in the column
+template <typename T>
+ColumnSumType<T> columnSum(const ColumnView<const T>& view) {
+  using SumT = ColumnSumType<T>;
+  return detail::reduce(view, SumT{0}, [](SumT a, SumT b) { return a + b; });
+}
+
+/// The smallest value in the column, std::numeric_limits<T>::max() for an empty
+/// column
+template <typename T>
+T columnMin(const ColumnView<const T>& view) {
+  return detail::reduce(view, std::numeric_limits<T>::max(), [](T a, T b) { return b < a ? b : a; });
+}
+
+/// The largest value in the column, std::numeric_limits<T>::lowest() for an
+/// empty column
+template <typename T>
+T columnMax(const ColumnView<const T>& view) {
+  return detail::reduce(view, std::numeric_limits<T>::lowest(), [](T a, T b) { return a < b ? b : a; });
+}
+
+/// The indices of all elements for which the predicate returns true
+template <typename T, typename Predicate>
+std::vector<size_t> columnSelect(const ColumnView<const T>& view, Predicate&& pred) {
+  std::vector<size_t> indices;
+  size_t i = 0;
+  detail::forEachElement(view, [&](const T& value) {
+    if (pred(value)) {
+      indices.push_back(i);
+    }
+    ++i;
+  });
+  return indices;
+}
+
+/// Replace every value in the column by the result of calling func with it
+template <typename T, typename Func>
+void columnTransform(const ColumnView<T>& view, Func&& func) {
+  static_assert(!std::is_const_v<T>, "Cannot transform the values of a read-only ColumnView");
+  detail::forEachElement(view, [&func](T& value) { value = func(value); });
+}
+
+} // namespace podio
+
+#endif // PODIO_COLUMNKERNELS_H
@@ -0,0 +1,219 @@
+#ifndef PODIO_COLUMNVIEW_H
+#define PODIO_COLUMNVIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace podio {
+/// A non-owning view of one member of all the elements of a collection. It
+/// allows to read (and for non-const T also to write) a single member without
+/// allocating or copying anything.
+///
+/// Depending on where the data live, the view works in one of two modes:
+/// - strided: The members are at a fixed distance (the stride, in bytes) from
+///   each other in memory, e.g. in the I/O buffer of the collection or in the
+///   objects if these are all in one block. The collections store whole
+///   objects, so the stride is always larger than the member itself.
+/// - indirect: Each member is accessed through a function that goes via the
+///   objects of the collection, for the cases where they do not live in one
+///   contiguous block of memory.
+/// The kernels in ColumnKernels.h therefore run scalar loops, either strided
+/// (see isStrided()) or through the objects. They cannot be vectorized until
+/// there is per-member storage.
+///
+/// The view stays valid as long as no elements are added to or removed from
+/// the collection.
+template <typename T>
+class ColumnView {
+  using BytePtr = std::conditional_t<std::is_const_v<T>, const std::byte*, std::byte*>;
+
+public:
+  using value_type = std::remove_const_t<T>;
+  using reference = T&;
+  using size_type = size_t;
+  /// The function that is used to access the element i in indirect mode. It is
+  /// the same for const and non-const views
+  using AccessFunc = value_type& (*)(const void* context, size_t i);
+
+  /// Random access iterator over all elements of the view
+  class Iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Iterator() = default;
+    Iterator(const ColumnView* view, size_t index) : m_view(view), m_index(index) {
+    }
+
+    reference operator*() const {
+      return (*m_view)[m_index];
+    }
+    pointer operator->() const {
+      return &(*m_view)[m_index];
+    }
+    reference operator[](difference_type n) const {
+      return (*m_view)[m_index + n];
+    }
+
+    Iterator& operator++() {
+      ++m_index;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto tmp = *this;
+      ++m_index;
+      return tmp;
+    }
+    Iterator& operator--() {
+      --m_index;
+      return *this;
+    }
+    Iterator operator--(int) {
+      auto tmp = *this;
+      --m_index;
+      return tmp;
+    }
+    Iterator& operator+=(difference_type n) {
+      m_index += n;
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+      m_index -= n;
+      return *this;
+    }
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) {
+      return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+    }
+
+    bool operator==(const Iterator& other) const {
+      return m_index == other.m_index;
+    }
+    bool operator!=(const Iterator& other) const {
+      return m_index != other.m_index;
+    }
+    bool operator<(const Iterator& other) const {
+      return m_index < other.m_index;
+    }
+    bool operator>(const Iterator& other) const {
+      return m_index > other.m_index;
+    }
+    bool operator<=(const Iterator& other) const {
+      return m_index <= other.m_index;
+    }
+    bool operator>=(const Iterator& other) const {
+      return m_index >= other.m_index;
+    }
+
+  private:
+    const ColumnView* m_view{nullptr};
+    size_t m_index{0};
+  };
+
+  /// An empty view
+  ColumnView() = default;
+
+  /// A strided view, where first points to the member of the first element and
+  /// stride is the distance in bytes between the members of two consecutive
+  /// elements
+  ColumnView(T* first, size_t stride, size_t size) : m_first(first), m_stride(stride), m_size(size) {
+  }
+
+  /// An indirect view, where the elements are accessed via the passed function
+  ColumnView(const void* context, AccessFunc access, size_t size) :
+      m_context(context), m_access(access), m_size(size) {
+  }
+
+  /// Every view can be turned into a read-only view
+  template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+  operator ColumnView<const U>() const {
+    if (m_access) {
+      return ColumnView<const U>(m_context, m_access, m_size);
+    }
+    return ColumnView<const U>(m_first, m_stride, m_size);
+  }
+
+  /// Number of elements in the view
+  size_t size() const {
+    return m_size;
+  }
+  /// Check if the view is empty
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  /// Indexed access
+  reference operator[](size_t i) const {
+    if (m_access) {
+      return m_access(m_context, i);
+    }
+    return *reinterpret_cast<T*>(reinterpret_cast<BytePtr>(m_first) + i * m_stride);
+  }
+  /// Indexed access with range check
+  reference at(size_t i) const {
+    if (i < m_size) {
+      return (*this)[i];
+    }
+    throw std::out_of_range("index out of bounds for ColumnView");
+  }
+
+  Iterator begin() const {
+    return Iterator(this, 0);
+  }
+  Iterator end() const {
+    return Iterator(this, m_size);
+  }
+
+  /// Whether all members are at a fixed distance from each other in memory
+  bool isStrided() const {
+    return m_access == nullptr;
+  }
+  /// Whether all members are directly next to each other in memory
+  bool isContiguous() const {
+    return isStrided() && (m_stride == sizeof(T) || m_size < 2);
+  }
+  /// Pointer to the first member for strided views, nullptr otherwise
+  T* data() const {
+    return isStrided() ? m_first : nullptr;
+  }
+  /// The distance in bytes between two consecutive members for strided views
+  size_t stride() const {
+    return m_stride;
+  }
+
+  /// Assign new values to all elements. The number of values has to match the
+  /// size of the view
+  template <typename Range, typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+  void assign(const Range& values) const {
+    if (static_cast<size_t>(std::distance(std::begin(values), std::end(values))) != m_size) {
+      throw std::invalid_argument("Number of values does not match the size of the ColumnView");
+    }
+    size_t i = 0;
+    for (const auto& value : values) {
+      (*this)[i++] = value;
+    }
+  }
+
+private:
+  T* m_first{nullptr};
+  size_t m_stride{sizeof(T)};
+  const void* m_context{nullptr};
+  AccessFunc m_access{nullptr};
+  size_t m_size{0};
+};
+} // namespace podio
+
+#endif // PODIO_COLUMNVIEW_H
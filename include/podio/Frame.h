@@ -3,13 +3,18 @@
 
 #include "podio/CollectionBase.h"
 #include "podio/CollectionBufferFactory.h"
+#include "podio/CollectionHandle.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionLayout.h"
 #include "podio/FrameCategories.h" // mainly for convenience
 #include "podio/GenericParameters.h"
 #include "podio/ICollectionProvider.h"
 #include "podio/SchemaEvolution.h"
 #include "podio/utilities/TypeHelpers.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <initializer_list>
 #include <memory>
 #include <mutex>
@@ -17,8 +22,11 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace podio {
@@ -57,6 +65,24 @@ namespace detail {
       return std::make_unique<podio::GenericParameters>();
     }
   };
+
+  /// Raw data types can optionally provide a CollectionLayout that is shared
+  /// between all Frames created from the same kind of raw data. It has to be
+  /// consistent with the collection ID table of the raw data
+  template <typename FrameDataT>
+  using hasCollectionLayout_t = decltype(std::declval<FrameDataT>().getCollectionLayout());
+
+  template <typename FrameDataT>
+  constexpr static bool hasCollectionLayout = det::is_detected_v<hasCollectionLayout_t, FrameDataT>;
+
+  /// Raw data types can optionally take back the collections that have been
+  /// created from them when a Frame is destroyed, e.g. to re-use their buffers
+  template <typename FrameDataT>
+  using hasRecycleCollection_t = decltype(std::declval<FrameDataT>().recycleCollection(
+      std::declval<const std::string&>(), std::declval<podio::CollectionBase&>()));
+
+  template <typename FrameDataT>
+  constexpr static bool hasRecycleCollection = det::is_detected_v<hasRecycleCollection_t, FrameDataT>;
 } // namespace detail
 
 template <typename FrameDataT>
@@ -81,6 +107,11 @@ class Frame {
 
     virtual std::vector<std::string> availableCollections() const = 0;
 
+    virtual void prefetch(const std::vector<std::string>& names, unsigned nThreads) const = 0;
+
+    virtual const std::shared_ptr<const podio::CollectionLayout>& collectionLayout() const = 0;
+    virtual const podio::CollectionBase* get(size_t slot) const = 0;
+
     // Writing interface. Need this to be able to store all necessary information
     // TODO: Figure out whether this can be "hidden" somehow
     virtual podio::CollectionIDTable getIDTable() const = 0;
@@ -92,7 +123,7 @@ class Frame {
   struct FrameModel final : FrameConcept, public ICollectionProvider {
 
     FrameModel(std::unique_ptr<FrameDataT> data);
-    ~FrameModel() = default;
+    ~FrameModel();
     FrameModel(const FrameModel&) = delete;
     FrameModel& operator=(const FrameModel&) = delete;
     FrameModel(FrameModel&&) = default;
@@ -125,9 +156,39 @@ class Frame {
 
     std::vector<std::string> availableCollections() const override;
 
+    /// Get the layout of the collections that are known from the raw data. This
+    /// is a nullptr if the raw data do not provide a (shared) layout
+    const std::shared_ptr<const podio::CollectionLayout>& collectionLayout() const override {
+      return m_layout;
+    }
+
+    /// Get the collection in the given slot of the layout, unpacking it if
+    /// necessary. Returns a nullptr if it is not available
+    const podio::CollectionBase* get(size_t slot) const override;
+
+    /// Unpack the collections concurrently on nThreads threads and resolve
+    /// their relations afterwards
+    void prefetch(const std::vector<std::string>& names, unsigned nThreads) const override;
+
   private:
     podio::CollectionBase* doGet(const std::string& name, bool setReferences = true) const;
 
+    /// Unpack a collection from the raw data and place it into the internal map
+    /// (without resolving its relations). Returns a nullptr if the raw data
+    /// do not (or no longer) contain the collection
+    podio::CollectionBase* unpackCollection(const std::string& name) const;
+
+    /// Set up the slots for the layout that is provided by the raw data (if
+    /// any)
+    void initCollectionSlots();
+
+    /// Get the slot for a collection ID, or a nullptr if there is none
+    std::atomic<podio::CollectionBase*>* collectionSlot(uint32_t collectionID) const;
+
+    /// Make a collection that has been placed into the internal map available
+    /// via its slot (if it has one)
+    void publishCollection(podio::CollectionBase* coll) const;
+
     using CollectionMapT = std::unordered_map<std::string, std::unique_ptr<podio::CollectionBase>>;
 
     mutable CollectionMapT m_collections{};                 ///< The internal map for storing unpacked collections
@@ -138,6 +199,14 @@ class Frame {
     std::unique_ptr<podio::GenericParameters> m_parameters{nullptr}; ///< The generic parameter store for this frame
     mutable std::set<uint32_t> m_retrievedIDs{}; ///< The IDs of the collections that we have already read (but not yet
                                                  ///< put into the map)
+    /// The layout of the collections that are known from the raw data (if the
+    /// raw data provide one). Fixed after construction, so that it can be used
+    /// without locking
+    std::shared_ptr<const podio::CollectionLayout> m_layout{nullptr};
+    /// The collections in the internal map indexed by their slot in m_layout. A
+    /// slot is filled once the collection is in the map and can be read
+    /// lock-free from then on
+    std::unique_ptr<std::atomic<podio::CollectionBase*>[]> m_collectionSlots{nullptr};
   };
 
   std::unique_ptr<FrameConcept> m_self; ///< The internal concept pointer through which all the work is done
@@ -196,6 +265,33 @@ public:
   template <typename CollT, typename = EnableIfCollection<CollT>>
   const CollT& get(const std::string& name) const;
 
+  /// Get a handle for quickly getting a collection from this Frame and all
+  /// Frames with the same collection layout.
+  ///
+  /// This is meant to be done once (e.g. for the first Frame of a category)
+  /// and the handle can then be used to get the collection from all subsequent
+  /// Frames (of the same category) without a lookup by name.
+  ///
+  /// @tparam CollT The type of the desired collection
+  /// @param  name  The name of the collection
+  ///
+  /// @returns      A handle for the collection. If the collection is not part
+  ///               of the layout of this Frame, e.g. because it has been put
+  ///               into it or because the Frame has no shared layout, the
+  ///               handle will fall back to the lookup by name
+  template <typename CollT, typename = EnableIfCollection<CollT>>
+  CollectionHandle<CollT> getHandle(const std::string& name) const;
+
+  /// Get a collection from the Frame via a handle.
+  ///
+  /// @tparam CollT  The type of the desired collection
+  /// @param  handle The handle of the collection (see getHandle)
+  ///
+  /// @returns       A const reference to the collection if it is available or
+  ///                to an empty (static) collection
+  template <typename CollT, typename = EnableIfCollection<CollT>>
+  const CollT& get(const CollectionHandle<CollT>& handle) const;
+
   /// Get a collection pointer from the Frame by name.
   ///
   /// This is a type-erased version that is also used by the python bindings.
@@ -315,6 +411,34 @@ public:
     return m_self->availableCollections();
   }
 
+  /// Unpack the passed collections in parallel.
+  ///
+  /// Collections are otherwise only unpacked from the raw data on the first
+  /// get, one at a time. This unpacks the passed collections (including the
+  /// creation of all their objects) concurrently and resolves their relations
+  /// afterwards, such that subsequent gets are only lookups. Collections that
+  /// have already been unpacked or that are not available are ignored.
+  ///
+  /// @note Call this before handing the Frame to other threads, since the
+  /// collections are only fully usable once this has returned.
+  ///
+  /// @param names    The names of the collections to unpack
+  /// @param nThreads The number of threads to use. Defaults to the number of
+  ///                 hardware threads
+  void prefetch(const std::vector<std::string>& names, unsigned nThreads = 0) const {
+    m_self->prefetch(names, nThreads);
+  }
+
+  /// Unpack all available collections in parallel.
+  ///
+  /// See prefetch for details.
+  ///
+  /// @param nThreads The number of threads to use. Defaults to the number of
+  ///                 hardware threads
+  void prefetchAll(unsigned nThreads = 0) const {
+    m_self->prefetch(m_self->availableCollections(), nThreads);
+  }
+
   /// Get the name of the passed collection
   ///
   /// @param coll The collection for which the name should be obtained
@@ -387,6 +511,32 @@ const CollT& Frame::get(const std::string& name) const {
   return emptyColl;
 }
 
+template <typename CollT, typename>
+CollectionHandle<CollT> Frame::getHandle(const std::string& name) const {
+  const auto& layout = m_self->collectionLayout();
+  if (!layout) {
+    return CollectionHandle<CollT>(name);
+  }
+  if (const auto slot = layout->slot(name)) {
+    return CollectionHandle<CollT>(name, layout, slot.value());
+  }
+  return CollectionHandle<CollT>(name);
+}
+
+template <typename CollT, typename>
+const CollT& Frame::get(const CollectionHandle<CollT>& handle) const {
+  if (!handle.isBound() || handle.m_layout != m_self->collectionLayout()) {
+    return get<CollT>(handle.name());
+  }
+  // Comparing the type_info is considerably cheaper than a dynamic_cast
+  const auto* coll = m_self->get(handle.m_slot);
+  if (coll && typeid(*coll) == typeid(CollT)) {
+    return static_cast<const CollT&>(*coll);
+  }
+  static const auto emptyColl = CollT();
+  return emptyColl;
+}
+
 inline const podio::CollectionBase* Frame::get(const std::string& name) const {
   return m_self->get(name);
 }
@@ -420,6 +570,18 @@ Frame::FrameModel<FrameDataT>::FrameModel(std::unique_ptr<FrameDataT> data) :
   m_data = std::move(data);
   m_idTable = std::move(m_data->getIDTable());
   m_parameters = std::move(m_data->getParameters());
+  initCollectionSlots();
+}
+
+template <typename FrameDataT>
+Frame::FrameModel<FrameDataT>::~FrameModel() {
+  if constexpr (detail::hasRecycleCollection<FrameDataT>) {
+    if (m_data) {
+      for (auto& [name, coll] : m_collections) {
+        m_data->recycleCollection(name, *coll);
+      }
+    }
+  }
 }
 
 template <typename FrameDataT>
@@ -440,9 +602,19 @@ podio::CollectionBase* Frame::FrameModel<FrameDataT>::doGet(const std::string& n
     }
   }
 
+  auto* retColl = unpackCollection(name);
+  if (retColl && setReferences) {
+    retColl->setReferences(this);
+  }
+
+  return retColl;
+}
+
+template <typename FrameDataT>
+podio::CollectionBase* Frame::FrameModel<FrameDataT>::unpackCollection(const std::string& name) const {
   podio::CollectionBase* retColl = nullptr;
 
-  // Now try to get it from the raw data if we have the possibility
+  // Try to get it from the raw data if we have the possibility
   if (m_data) {
     // Have the buffers in the outer scope here to hold the raw data lock as
     // briefly as possible
@@ -471,10 +643,7 @@ podio::CollectionBase* Frame::FrameModel<FrameDataT>::doGet(const std::string& n
         // TODO: Collision handling?
         retColl = it->second.get();
       }
-
-      if (setReferences) {
-        retColl->setReferences(this);
-      }
+      publishCollection(retColl);
     }
   }
 
@@ -483,6 +652,15 @@ podio::CollectionBase* Frame::FrameModel<FrameDataT>::doGet(const std::string& n
 
 template <typename FrameDataT>
 bool Frame::FrameModel<FrameDataT>::get(uint32_t collectionID, CollectionBase*& collection) const {
+  // Fast path for collections that have already been retrieved, which is the
+  // case for all but the first lookup of each collection
+  if (const auto* slot = collectionSlot(collectionID)) {
+    if (auto* coll = slot->load(std::memory_order_acquire)) {
+      collection = coll;
+      return true;
+    }
+  }
+
   const auto name = m_idTable.name(collectionID);
   if (!name) {
     return false;
@@ -518,6 +696,7 @@ const podio::CollectionBase* Frame::FrameModel<FrameDataT>::put(std::unique_ptr<
       // -> Check before we emplace it into the internal map to prevent possible
       //    collisions from collections that are potentially present from rawdata?
       it->second->setID(m_idTable.add(name));
+      publishCollection(it->second.get());
       return it->second.get();
     } else {
       throw std::invalid_argument("An object with key " + name + " already exists in the frame");
@@ -527,6 +706,109 @@ const podio::CollectionBase* Frame::FrameModel<FrameDataT>::put(std::unique_ptr<
   return nullptr;
 }
 
+template <typename FrameDataT>
+void Frame::FrameModel<FrameDataT>::prefetch(const std::vector<std::string>& names, unsigned nThreads) const {
+  std::vector<podio::CollectionBase*> unpacked(names.size(), nullptr);
+  std::atomic<size_t> next{0};
+  std::exception_ptr error{nullptr};
+  std::mutex errorMtx{};
+
+  // The collections are independent of each other until their relations are
+  // resolved, so they can be unpacked and have their objects created
+  // concurrently. Each thread simply picks the next collection until all are
+  // done
+  const auto worker = [&]() {
+    try {
+      for (auto i = next++; i < names.size(); i = next++) {
+        if (auto* coll = unpackCollection(names[i])) {
+          coll->materialize();
+          unpacked[i] = coll;
+        }
+      }
+    } catch (...) {
+      std::lock_guard lock{errorMtx};
+      if (!error) {
+        error = std::current_exception();
+      }
+      next = names.size();
+    }
+  };
+
+  if (nThreads == 0) {
+    nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  nThreads = static_cast<unsigned>(std::min<size_t>(nThreads, names.size()));
+
+  std::vector<std::thread> threads{};
+  for (unsigned i = 1; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  // All objects of the prefetched collections exist at this point and relations
+  // only point to these objects, so the order in which the references are set
+  // does not matter. It has to happen serially, since it can trigger the
+  // unpacking of further (not prefetched) collections
+  for (auto* coll : unpacked) {
+    if (coll) {
+      coll->setReferences(this);
+    }
+  }
+}
+
+template <typename FrameDataT>
+void Frame::FrameModel<FrameDataT>::initCollectionSlots() {
+  // Use the layout that is shared by all Frames of the same kind if the raw
+  // data can provide it
+  if constexpr (detail::hasCollectionLayout<FrameDataT>) {
+    m_layout = m_data->getCollectionLayout();
+  }
+  // Without a shared layout all lookups go through the internal map. Building a
+  // layout for every single Frame would cost more than it saves
+  if (!m_layout) {
+    return;
+  }
+  m_collectionSlots = std::make_unique<std::atomic<podio::CollectionBase*>[]>(m_layout->size());
+  for (size_t i = 0; i < m_layout->size(); ++i) {
+    m_collectionSlots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+template <typename FrameDataT>
+std::atomic<podio::CollectionBase*>* Frame::FrameModel<FrameDataT>::collectionSlot(uint32_t collectionID) const {
+  if (!m_layout) {
+    return nullptr;
+  }
+  const auto slot = m_layout->slot(collectionID);
+  if (!slot) {
+    // Collections that are put into the Frame with a new name only become known
+    // after construction and go through the (locked) lookup by name
+    return nullptr;
+  }
+  return &m_collectionSlots[slot.value()];
+}
+
+template <typename FrameDataT>
+const podio::CollectionBase* Frame::FrameModel<FrameDataT>::get(size_t slot) const {
+  if (auto* coll = m_collectionSlots[slot].load(std::memory_order_acquire)) {
+    return coll;
+  }
+  return doGet(m_layout->name(slot));
+}
+
+template <typename FrameDataT>
+void Frame::FrameModel<FrameDataT>::publishCollection(podio::CollectionBase* coll) const {
+  if (auto* slot = collectionSlot(coll->getID())) {
+    slot->store(coll, std::memory_order_release);
+  }
+}
+
 template <typename FrameDataT>
 std::vector<std::string> Frame::FrameModel<FrameDataT>::availableCollections() const {
   // TODO: Check if there is a more efficient way to do this. Currently this is
@@ -120,6 +120,13 @@ public:
   template <typename T, typename = EnableIfValidGenericDataType<T>>
   std::tuple<std::vector<std::string>, std::vector<std::vector<T>>> getKeysAndValues() const;
 
+  /// Get all the available keys and values for a given type by copying them
+  /// into the passed vectors. The existing elements (and their capacity) are
+  /// re-used, such that filling the same vectors repeatedly does not allocate
+  /// once they are large enough
+  template <typename T, typename = EnableIfValidGenericDataType<T>>
+  void getKeysAndValues(std::vector<std::string>& keys, std::vector<std::vector<T>>& values) const;
+
   /// erase all elements
   void clear() {
     _intMap.clear();
@@ -280,7 +287,24 @@ std::tuple<std::vector<std::string>, std::vector<std::vector<T>>> GenericParamet
       values.emplace_back(v);
     }
   }
-  return {keys, values};
+  return {std::move(keys), std::move(values)};
+}
+
+template <typename T, typename>
+void GenericParameters::getKeysAndValues(std::vector<std::string>& keys, std::vector<std::vector<T>>& values) const {
+  auto& mtx = getMutex<T>();
+  const auto& map = getMap<T>();
+  // Lock to avoid concurrent changes to the map while we get the stored values
+  std::lock_guard lock{mtx};
+  keys.resize(map.size());
+  values.resize(map.size());
+
+  size_t i = 0;
+  for (const auto& [k, v] : map) {
+    keys[i] = k;
+    values[i].assign(v.begin(), v.end());
+    ++i;
+  }
 }
 
 template <typename T, template <typename...> typename VecLike>
@@ -0,0 +1,148 @@
+#ifndef PODIO_RNTUPLEPARALLELWRITER_H
+#define PODIO_RNTUPLEPARALLELWRITER_H
+
+#include "podio/RNTupleWriter.h"
+
+#include "TFile.h"
+#include <ROOT/RNTupleFillContext.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleParallelWriter.hxx>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace podio {
+
+namespace detail {
+  /// The state of a RNTupleParallelWriter that is shared with all the writers
+  /// it has handed out. These keep it alive, so that they never fill already
+  /// destroyed RNTuples, even if they outlive the RNTupleParallelWriter
+  struct RNTupleParallelWriterState {
+    // The file has to outlive the RNTuple writers, which commit into it when
+    // they are destroyed
+    std::unique_ptr<TFile> file{nullptr}; ///< The output file
+    RNTupleWriter::Options options{};     ///< The settings for all writers
+    std::mutex mutex{};                   ///< Guards the state shared by all writers
+    /// Serializes all writes into the file. The RNTuples of all categories go
+    /// into the same file, but each is only synchronized in itself. Always
+    /// acquired after mutex if both are needed
+    std::mutex fileMutex{};
+    /// The metadata of all categories
+    std::unordered_map<std::string, RNTupleWriter::CategoryInfo> categories{};
+    /// The writers for the RNTuples of all categories
+    std::unordered_map<std::string, std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter>> writers{};
+    unsigned activeWriters{0}; ///< The number of unfinished writers
+
+    /// The datamodel definitions of all writers
+    std::vector<std::tuple<std::string, std::string>> edmDefinitions{};
+
+    bool finished{false}; ///< Whether writing has been actually done
+  };
+} // namespace detail
+
+/// The RNTupleParallelWriter writes podio files from several threads at the
+/// same time into one ROOT file using the RNTuple format.
+///
+/// It hands out RNTupleWriters that can be used independently of each other
+/// (e.g. one per thread). All of them fill the same RNTuple for each category,
+/// each with its own clusters that are compressed on the filling thread. The
+/// contents of each category have to be the same for all writers, and the
+/// metadata that are necessary for reading the file are written once in
+/// finish().
+///
+/// All categories are written into the same file, so only one cluster is
+/// written at a time, regardless of the category. With ROOT versions before
+/// 6.34 every fill has to wait for this, since any fill can flush a cluster.
+///
+/// Files written with the RNTupleParallelWriter can be read with the
+/// RNTupleReader. The order of the entries in the output file depends on the
+/// order in which the clusters of the writers are flushed.
+class RNTupleParallelWriter {
+public:
+  /// Create a RNTupleParallelWriter to write to a file.
+  ///
+  /// @note Existing files will be overwritten without warning.
+  ///
+  /// @param filename The path to the file that will be created.
+  RNTupleParallelWriter(const std::string& filename);
+
+  /// Create a RNTupleParallelWriter to write to a file with the given
+  /// settings, which are used by all writers.
+  ///
+  /// @note Existing files will be overwritten without warning. Buffered
+  /// writing is always enabled, since it is necessary for filling from several
+  /// threads.
+  ///
+  /// @param filename The path to the file that will be created.
+  /// @param options  The compression and page / cluster settings
+  RNTupleParallelWriter(const std::string& filename, const RNTupleWriter::Options& options);
+
+  /// RNTupleParallelWriter destructor
+  ///
+  /// This also writes the metadata, in case all writers have already been
+  /// finished. Otherwise, an error is printed and the output file will not be
+  /// readable, since the metadata are missing.
+  ~RNTupleParallelWriter();
+
+  /// The RNTupleParallelWriter is not copy-able
+  RNTupleParallelWriter(const RNTupleParallelWriter&) = delete;
+  /// The RNTupleParallelWriter is not copy-able
+  RNTupleParallelWriter& operator=(const RNTupleParallelWriter&) = delete;
+
+  /// Get a new writer. Writers are not thread-safe themselves, but different
+  /// writers can be used concurrently, also for the same category.
+  ///
+  /// @note All writers have to be finished (or destroyed) before this
+  /// RNTupleParallelWriter is finished.
+  ///
+  /// @returns A RNTupleWriter that writes into the output file of this writer
+  ///
+  /// @throws std::runtime_error if this writer has already been finished
+  std::unique_ptr<RNTupleWriter> getWriter();
+
+  /// Write the metadata and all remaining data into the output file.
+  ///
+  /// @note The destructor will also call this, so letting a
+  /// RNTupleParallelWriter go out of scope after all writers are done is also a
+  /// viable way to write a readable file.
+  ///
+  /// @throws std::runtime_error if there are writers that have not yet been
+  /// finished
+  void finish();
+
+private:
+  friend class RNTupleWriter;
+
+  /// Register the contents of a category from the first Frame that a writer
+  /// writes and get a fill context for it. The RNTuple for the category is
+  /// created from the passed model by the first writer. Throws if the contents
+  /// are not consistent with what other writers have registered before
+  static std::shared_ptr<ROOT::Experimental::RNTupleFillContext>
+  registerCategory(detail::RNTupleParallelWriterState& state, const std::string& category,
+                   const RNTupleWriter::CategoryInfo& catInfo, std::unique_ptr<ROOT::Experimental::RNTupleModel> model);
+
+  /// Fill the entry via the fill context of a writer. Clusters are only
+  /// written to the file while holding the file lock
+  static void fill(detail::RNTupleParallelWriterState& state, ROOT::Experimental::RNTupleFillContext& fillContext,
+                   ROOT::Experimental::REntry& entry);
+
+  /// Destroy the fill context of a writer, which writes its last cluster to
+  /// the file, while holding the file lock
+  static void releaseFillContext(detail::RNTupleParallelWriterState& state,
+                                 std::shared_ptr<ROOT::Experimental::RNTupleFillContext>& fillContext);
+
+  /// Take over the datamodel definitions of a writer that has finished
+  static void writerFinished(detail::RNTupleParallelWriterState& state,
+                             const std::vector<std::tuple<std::string, std::string>>& edmDefinitions);
+
+  /// The state that is shared with all writers
+  std::shared_ptr<detail::RNTupleParallelWriterState> m_state{nullptr};
+};
+
+} // namespace podio
+
+#endif // PODIO_RNTUPLEPARALLELWRITER_H
@@ -6,17 +6,24 @@
 #include "podio/podioVersion.h"
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
 
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <ROOT/REntry.hxx>
 #include <ROOT/RNTuple.hxx>
 #include <ROOT/RNTupleModel.hxx>
 #include <RVersion.h>
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
   #include <ROOT/RNTupleReader.hxx>
 #endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  #include <ROOT/RNTupleView.hxx>
+#endif
 
 namespace podio {
 
@@ -56,6 +63,11 @@ public:
   /// - This usually boils down to "the files have been written with the same
   ///   "settings", e.g. they are outputs of a batched process.
   ///
+  /// Only the first file is opened directly. The others are opened once
+  /// entries are read from them (or the total number of entries is requested),
+  /// at which point it is also checked that their contents match the ones of
+  /// the first file.
+  ///
   /// @param filenames The filenames of all input files that should be read
   void openFiles(const std::vector<std::string>& filenames);
 
@@ -68,6 +80,27 @@ public:
   ///          Otherwise a nullptr
   std::unique_ptr<podio::ROOTFrameData> readNextEntry(const std::string& name);
 
+  /// Read the next data entry for a given category, but only the passed
+  /// collections (and the collections they are related to).
+  ///
+  /// Only the fields of the requested collections are read, using separate
+  /// readers for each collection. Since the targets of their relations are
+  /// only known after reading them, the collections they point to are added to
+  /// the collections to read for this entry, such that all relations can be
+  /// resolved.
+  ///
+  /// @param name        The category name for which to read the next entry
+  /// @param collsToRead The names of the collections to read. All collections
+  ///                    are read if this is empty
+  ///
+  /// @returns FrameData from which a podio::Frame can be constructed if the
+  ///          category exists and if there are still entries left to read.
+  ///          Otherwise a nullptr
+  ///
+  /// @throws std::invalid_argument if any of the collections is not available
+  std::unique_ptr<podio::ROOTFrameData> readNextEntry(const std::string& name,
+                                                      const std::vector<std::string>& collsToRead);
+
   /// Read the desired data entry for a given category.
   ///
   /// @param name  The category name for which to read the next entry
@@ -75,8 +108,27 @@ public:
   ///
   /// @returns FrameData from which a podio::Frame can be constructed if the
   ///          category and the desired entry exist. Otherwise a nullptr
+  ///
+  /// @throws std::runtime_error if the collections in the file containing the
+  ///         entry differ from the ones in the first file
   std::unique_ptr<podio::ROOTFrameData> readEntry(const std::string& name, const unsigned entry);
 
+  /// Read the desired data entry for a given category, but only the passed
+  /// collections (and the collections they are related to). See readNextEntry
+  /// for details.
+  ///
+  /// @param name        The category name for which to read the next entry
+  /// @param entry       The entry number to read
+  /// @param collsToRead The names of the collections to read. All collections
+  ///                    are read if this is empty
+  ///
+  /// @returns FrameData from which a podio::Frame can be constructed if the
+  ///          category and the desired entry exist. Otherwise a nullptr
+  ///
+  /// @throws std::invalid_argument if any of the collections is not available
+  std::unique_ptr<podio::ROOTFrameData> readEntry(const std::string& name, const unsigned entry,
+                                                  const std::vector<std::string>& collsToRead);
+
   /// Get the names of all the available Frame categories in the current file(s).
   ///
   /// @returns The names of the available categores from the file
@@ -120,25 +172,148 @@ private:
    */
   bool initCategory(const std::string& category);
 
+  /// Pointers to the values of the parameter fields of type T in an entry
+  template <typename T>
+  struct ParamFields {
+    std::vector<std::string>* keys{nullptr};
+    std::vector<std::vector<T>>* values{nullptr};
+  };
+
+  /// Pointers to the values of all the parameter fields
+  using AllParamFields =
+      std::tuple<ParamFields<int>, ParamFields<float>, ParamFields<double>, ParamFields<std::string>>;
+
+  /// An entry that is re-used for reading all entries from one reader. Only the
+  /// collection buffers are bound anew for every entry, the parameters (if
+  /// the reader has them) are read into the values owned by the entry
+  struct ReusableEntry {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
+    std::unique_ptr<ROOT::Experimental::REntry> entry{nullptr};
+#else
+    ROOT::Experimental::REntry* entry{nullptr};
+#endif
+    AllParamFields params{};
+  };
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  /// The views into the reader of a category in one file that are used to read
+  /// only some of the collections. The collection views are created once they
+  /// are first needed and are bound to the buffers anew for every entry, the
+  /// parameters are read into the values owned by their views
+  struct ProjectedViews {
+    std::vector<std::vector<ROOT::Experimental::RNTupleView<void>>> collections{};
+    std::vector<ROOT::Experimental::RNTupleView<void>> params{};
+    AllParamFields paramFields{};
+  };
+#endif
+
+  /// The names of the fields to which the buffers of one collection are bound
+  struct CollectionFields {
+    std::string data{};                 ///< The data field (empty for subset collections)
+    std::vector<std::string> refs{};    ///< The fields for the relations (or the subset collection)
+    std::vector<std::string> vecMems{}; ///< The fields for the vector members
+  };
+
   /**
-   * Read and reconstruct the generic parameters of the Frame
+   * Read and reconstruct the generic parameters of the Frame from the last
+   * entry that has been loaded into the passed parameter fields
    */
-  GenericParameters readEventMetaData(const std::string& name, unsigned entNum);
+  GenericParameters readEventMetaData(AllParamFields& paramFields);
 
   template <typename T>
-  void readParams(const std::string& name, unsigned entNum, GenericParameters& params);
+  void readParams(AllParamFields& paramFields, GenericParameters& params);
+
+  /**
+   * Get the re-usable entry for the reader of the given category in the file
+   * with the passed index, creating it if necessary
+   */
+  ReusableEntry& getReusableEntry(const std::string& category, size_t iFile);
+
+  /**
+   * Create the re-usable entry for the passed reader. Binds the parameters if
+   * requested
+   */
+  static void createReusableEntry(ROOT::Experimental::RNTupleReader& reader, ReusableEntry& entry, bool withParams);
+
+  /**
+   * Create the buffers for the collection at index iColl of the category.
+   * Returns an empty optional if the buffers cannot be created
+   */
+  std::optional<podio::CollectionReadBuffers> createCollectionBuffers(const std::string& category, size_t iColl);
+
+  /**
+   * Create the buffers for the collection at index iColl of the category and
+   * bind them to the fields in the passed entry. Returns an empty optional if
+   * the buffers cannot be created
+   */
+  std::optional<podio::CollectionReadBuffers> bindCollectionBuffers(ROOT::Experimental::REntry& entry,
+                                                                    const std::string& category, size_t iColl);
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  /**
+   * Get the views into the reader of the category in the file with the passed
+   * index, creating the views for the parameters if necessary
+   */
+  ProjectedViews& getProjectedViews(const std::string& category, size_t iFile);
+
+  /**
+   * Read the collection at index iColl of the category from the passed entry
+   * of the file with the passed index, using only the views of its fields.
+   * Returns an empty optional if the buffers cannot be created
+   */
+  std::optional<podio::CollectionReadBuffers> readCollectionViews(const std::string& category, size_t iFile,
+                                                                  unsigned localEntry, size_t iColl);
+#endif
+
+  /**
+   * Get the indices of the collections to which the relations in the passed
+   * buffers point
+   */
+  std::vector<size_t> getRelationTargets(const std::string& category, const podio::CollectionReadBuffers& buffers);
+
+  /**
+   * Open the reader for the given category in the next file that has not yet
+   * been opened for this category. Returns false if all files have already
+   * been opened
+   */
+  bool openNextReader(const std::string& category);
+
+  /**
+   * Get the index of the file that contains the (global) entry of the given
+   * category as well as the local entry number in that file. Opens the readers
+   * for the files as necessary. Returns an empty optional if the entry does not
+   * exist
+   */
+  std::optional<std::pair<size_t, unsigned>> getFileAndEntry(const std::string& category, unsigned entNum);
+
+  /**
+   * Get the reader for the metadata of the given file, opening it if necessary
+   */
+  ROOT::Experimental::RNTupleReader& getMetadataReader(const std::string& filename);
 
   std::unique_ptr<ROOT::Experimental::RNTupleReader> m_metadata{};
 
   podio::version::Version m_fileVersion{};
   DatamodelDefinitionHolder m_datamodelHolder{};
 
+  /// The readers for each category. One per opened file, in the order of the
+  /// files. A nullptr in case a file does not contain the category
   std::unordered_map<std::string, std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>>> m_readers{};
+  /// The accumulated number of entries for each category up to and including
+  /// the file at the same index in m_readers
+  std::unordered_map<std::string, std::vector<unsigned>> m_readerEntries{};
+  /// The re-usable entries for each category, at the same index as the reader
+  /// they belong to in m_readers
+  std::unordered_map<std::string, std::vector<ReusableEntry>> m_reusableEntries{};
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  /// The views for reading single collections for each category, at the same
+  /// index as the reader they belong to in m_readers
+  std::unordered_map<std::string, std::vector<ProjectedViews>> m_projectedViews{};
+#endif
   std::unordered_map<std::string, std::unique_ptr<ROOT::Experimental::RNTupleReader>> m_metadata_readers{};
   std::vector<std::string> m_filenames{};
 
   std::unordered_map<std::string, int> m_entries{};
-  std::unordered_map<std::string, unsigned> m_totalEntries{};
 
   struct CollectionInfo {
     std::vector<unsigned int> id{};
@@ -146,13 +321,28 @@ private:
     std::vector<std::string> type{};
     std::vector<short> isSubsetCollection{};
     std::vector<SchemaVersionT> schemaVersion{};
+
+    bool operator==(const CollectionInfo& other) const {
+      return id == other.id && name == other.name && type == other.type &&
+          isSubsetCollection == other.isSubsetCollection && schemaVersion == other.schemaVersion;
+    }
   };
 
+  /**
+   * Read the information about the collections of a category from the passed
+   * metadata reader
+   */
+  static CollectionInfo readCollectionInfo(ROOT::Experimental::RNTupleReader& metadata, const std::string& category);
+
   std::unordered_map<std::string, CollectionInfo> m_collectionInfo{};
+  /// The fields for all collections of each category, in the same order as
+  /// in the CollectionInfo
+  std::unordered_map<std::string, std::vector<CollectionFields>> m_collectionFields{};
 
   std::vector<std::string> m_availableCategories{};
 
   std::unordered_map<std::string, std::shared_ptr<podio::CollectionIDTable>> m_idTables{};
+  std::unordered_map<std::string, std::shared_ptr<const podio::CollectionLayout>> m_collectionLayouts{};
 };
 
 } // namespace podio
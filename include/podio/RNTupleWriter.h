@@ -8,19 +8,31 @@
 #include "podio/utilities/RootHelpers.h"
 
 #include "TFile.h"
+#include <ROOT/REntry.hxx>
 #include <ROOT/RNTuple.hxx>
 #include <ROOT/RNTupleModel.hxx>
 #include <RVersion.h>
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
   #include <ROOT/RNTupleWriter.hxx>
 #endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  #include <ROOT/RNTupleFillContext.hxx>
+#endif
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 namespace podio {
 
+class RNTupleParallelWriter;
+namespace detail {
+  struct RNTupleParallelWriterState;
+}
+
 /// The RNTupleWriter writes podio files into ROOT files using the new RNTuple
 /// format.
 ///
@@ -31,6 +43,37 @@ namespace podio {
 /// Files written with the RNTupleWriter can be read with the RNTupleReader.
 class RNTupleWriter {
 public:
+  /// The settings for writing a file. The defaults are the ROOT defaults
+  struct Options {
+    /// The compression algorithm (ROOT::RCompressionSetting::EAlgorithm)
+    ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm{
+        ROOT::RCompressionSetting::EAlgorithm::kUseGlobal};
+    /// The compression level (0 - 9). Negative values use the ROOT default
+    /// compression settings for RNTuples (and ignore the compression algorithm)
+    int compressionLevel{-1};
+    /// The approximate size of the compressed clusters in bytes. 0 uses the
+    /// ROOT default
+    std::size_t approxZippedClusterSize{0};
+    /// The (maximum) size of the uncompressed pages in bytes. 0 uses the ROOT
+    /// default
+    std::size_t unzippedPageSize{0};
+    /// Buffer the pages of a cluster before writing them. Necessary for
+    /// parallel compression and for the RNTupleParallelWriter
+    bool useBufferedWrite{true};
+    /// Compress the pages in parallel, using ROOTs implicit multi-threading.
+    /// Preferably enable that before creating the writer
+    /// (ROOT::EnableImplicitMT). Otherwise the writer enables it, but it will
+    /// not disable it again, since other components might use it in the
+    /// meantime
+    bool parallelCompression{false};
+    /// The number of threads for parallel compression if the writer enables
+    /// implicit multi-threading. 0 uses all available cores
+    unsigned nThreads{0};
+
+    /// The RNTupleWriteOptions for these settings
+    ROOT::Experimental::RNTupleWriteOptions writeOptions() const;
+  };
+
   /// Create a RNTupleWriter to write to a file.
   ///
   /// @note Existing files will be overwritten without warning.
@@ -38,6 +81,14 @@ public:
   /// @param filename The path to the file that will be created.
   RNTupleWriter(const std::string& filename);
 
+  /// Create a RNTupleWriter to write to a file with the given settings.
+  ///
+  /// @note Existing files will be overwritten without warning.
+  ///
+  /// @param filename The path to the file that will be created.
+  /// @param options  The compression and page / cluster settings
+  RNTupleWriter(const std::string& filename, const Options& options);
+
   /// RNTupleWriter destructor
   ///
   /// This also takes care of writing all the necessary metadata in order to be
@@ -102,14 +153,41 @@ public:
   checkConsistency(const std::vector<std::string>& collsToWrite, const std::string& category) const;
 
 private:
+  friend class RNTupleParallelWriter;
+  friend struct detail::RNTupleParallelWriterState;
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  /// Create a RNTupleWriter that fills the RNTuples of the parallel writer
+  /// with the passed state. Only used by the parallel writer.
+  RNTupleWriter(std::shared_ptr<detail::RNTupleParallelWriterState> parent, const Options& options);
+#endif
+
+  /// The names of the fields to which the buffers of one collection are bound
+  struct CollectionFields {
+    std::string data{};                 ///< The data field (empty for subset collections)
+    std::vector<std::string> refs{};    ///< The fields for the relations (or the subset collection)
+    std::vector<std::string> vecMems{}; ///< The fields for the vector members
+  };
+
+  /// Create the model for the passed collections and fill the names of the
+  /// fields that belong to each collection (in the same order)
   std::unique_ptr<ROOT::Experimental::RNTupleModel>
-  createModels(const std::vector<root_utils::StoreCollection>& collections);
+  createModels(const std::vector<root_utils::StoreCollection>& collections, std::vector<CollectionFields>& fields);
 
   /// Helper struct to group all the necessary information for one category.
   struct CategoryInfo {
     std::unique_ptr<ROOT::Experimental::RNTupleWriter> writer{nullptr}; ///< The RNTupleWriter for this category
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+    /// The fill context for this category if this writer belongs to a parallel writer
+    std::shared_ptr<ROOT::Experimental::RNTupleFillContext> fillContext{nullptr};
+#endif
+
+    /// The bare entry that is re-used for filling all Frames of this category.
+    /// It has to be destroyed before the writer / fill context
+    std::unique_ptr<ROOT::Experimental::REntry> entry{nullptr};
 
     // The following are assumed to run in parallel!
+    std::vector<CollectionFields> fields{};       ///< The names of the fields of all collections
     std::vector<uint32_t> ids{};                  ///< The ids of all collections
     std::vector<std::string> names{};             ///< The names of all collections
     std::vector<std::string> types{};             ///< The types of all collections
@@ -125,13 +203,26 @@ private:
   };
   CategoryInfo& getCategoryInfo(const std::string& category);
 
+  /// Bind the parameter storage of type T to the entry of the category
+  template <typename T>
+  void bindParamStorage(CategoryInfo& catInfo);
+
   template <typename T>
-  void fillParams(const GenericParameters& params, CategoryInfo& catInfo, ROOT::Experimental::REntry* entry);
+  void fillParams(const GenericParameters& params, CategoryInfo& catInfo);
 
   template <typename T>
   root_utils::ParamStorage<T>& getParamStorage(CategoryInfo& catInfo);
 
+  /// Write the metadata RNTuple with everything that is necessary for reading
+  /// the passed categories
+  static void writeMetadata(TFile& file, std::vector<std::tuple<std::string, std::string>> edmDefinitions,
+                            const std::unordered_map<std::string, CategoryInfo>& categories,
+                            const Options& options);
+
   std::unique_ptr<TFile> m_file{};
+  Options m_options{}; ///< The settings for writing
+  /// The state of the parallel writer that has handed out this writer (if any)
+  std::shared_ptr<detail::RNTupleParallelWriterState> m_parent{nullptr};
 
   DatamodelDefinitionCollector m_datamodelCollector{};
 
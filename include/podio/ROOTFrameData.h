@@ -1,22 +1,31 @@
 #ifndef PODIO_ROOTFRAMEDATA_H
 #define PODIO_ROOTFRAMEDATA_H
 
+#include "podio/CollectionBufferPool.h"
 #include "podio/CollectionBuffers.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionLayout.h"
 #include "podio/GenericParameters.h"
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace podio {
 
 class ROOTFrameData {
   using CollIDPtr = std::shared_ptr<const podio::CollectionIDTable>;
+  using LayoutPtr = std::shared_ptr<const podio::CollectionLayout>;
+  using PoolPtr = std::shared_ptr<podio::CollectionBufferPool>;
 
 public:
   using BufferMap = std::unordered_map<std::string, podio::CollectionReadBuffers>;
+  /// Function to read the buffers of a collection only once they are requested
+  using LazyReadFunc = std::function<std::optional<podio::CollectionReadBuffers>(const std::string&)>;
 
   ROOTFrameData() = delete;
   ~ROOTFrameData();
@@ -25,7 +34,11 @@ public:
   ROOTFrameData(const ROOTFrameData&) = delete;
   ROOTFrameData& operator=(const ROOTFrameData&) = delete;
 
-  ROOTFrameData(BufferMap&& buffers, CollIDPtr&& idTable, podio::GenericParameters&& params);
+  /// Create from the already read buffers. The buffers of the collections in
+  /// lazyCollections are only read via lazyRead once they are requested
+  ROOTFrameData(BufferMap&& buffers, CollIDPtr&& idTable, podio::GenericParameters&& params,
+                LayoutPtr layout = nullptr, PoolPtr bufferPool = nullptr,
+                std::vector<std::string> lazyCollections = {}, LazyReadFunc lazyRead = nullptr);
 
   std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name);
 
@@ -35,12 +48,30 @@ public:
 
   std::vector<std::string> getAvailableCollections() const;
 
+  /// Get the collection layout that is shared by all Frames of this category
+  LayoutPtr getCollectionLayout() const {
+    return m_layout;
+  }
+
+  /// Put the buffers of a collection that has been created from this data
+  /// back into the buffer pool (if there is one)
+  void recycleCollection(const std::string& name, podio::CollectionBase& coll);
+
 private:
   // TODO: switch to something more elegant once the basic functionality and
   // interface is better defined
   BufferMap m_buffers{};
   // This is co-owned by each FrameData and the original reader. (for now at least)
   CollIDPtr m_idTable{nullptr};
+  // Same as the id table
+  LayoutPtr m_layout{nullptr};
+  // Same as the id table. Only present if buffers should be re-used
+  PoolPtr m_bufferPool{nullptr};
+  // The names of the collections for which buffers have been handed out
+  std::unordered_set<std::string> m_handedOut{};
+  // The names of the collections that have not yet been read
+  std::unordered_set<std::string> m_lazyCollections{};
+  LazyReadFunc m_lazyRead{nullptr};
   podio::GenericParameters m_parameters{};
 };
 
@@ -0,0 +1,135 @@
+#ifndef PODIO_ROOTPARALLELWRITER_H
+#define PODIO_ROOTPARALLELWRITER_H
+
+#include "podio/CollectionIDTable.h"
+#include "podio/ROOTWriter.h"
+#include "podio/utilities/RootHelpers.h"
+
+#include "ROOT/TBufferMerger.hxx"
+#include "RVersion.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace podio {
+
+namespace detail {
+  /// The state of a ROOTParallelWriter that is shared with all the writers it
+  /// has handed out. These keep it alive, so that they never write into an
+  /// already destroyed merger, even if they outlive the ROOTParallelWriter
+  struct ROOTParallelWriterState {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 26, 0)
+    using BufferMerger = ROOT::TBufferMerger;
+#else
+    using BufferMerger = ROOT::Experimental::TBufferMerger;
+#endif
+
+    /// The metadata of a category that are written once for all writers
+    struct CategoryInfo {
+      podio::CollectionIDTable idTable{};                       ///< The collection id table for this category
+      std::vector<root_utils::CollectionWriteInfoT> collInfo{}; ///< Collection info for this category
+      std::vector<std::string> collsToWrite{};                  ///< The collections to write for this category
+    };
+
+    std::unique_ptr<BufferMerger> merger{nullptr};              ///< The merger for the output file
+    std::mutex mutex{};                                         ///< Guards the state shared by all writers
+    std::unordered_map<std::string, CategoryInfo> categories{}; ///< All categories
+    unsigned activeWriters{0};                                  ///< The number of unfinished writers
+
+    /// The datamodel definitions of all writers
+    std::vector<std::tuple<std::string, std::string>> edmDefinitions{};
+
+    bool finished{false}; ///< Whether writing has been actually done
+  };
+} // namespace detail
+
+/// The ROOTParallelWriter writes podio files from several threads at the same
+/// time into one ROOT file using TTrees.
+///
+/// It hands out ROOTWriters that can be used independently of each other (e.g.
+/// one per thread). Each of them writes into its own in-memory file and all of
+/// them are merged into the output file via a TBufferMerger. The contents of
+/// each category have to be the same for all writers, and the metadata that
+/// are necessary for reading the file are written once in finish(). The
+/// writers pass their data on to the merger whenever the baskets of a category
+/// are flushed (see ROOTWriter::CategoryOptions::autoFlush).
+///
+/// Files written with the ROOTParallelWriter can be read with the ROOTReader.
+/// The order of the entries in the output file depends on the order in which
+/// the writers are finished.
+class ROOTParallelWriter {
+public:
+  /// Create a ROOTParallelWriter to write to a file.
+  ///
+  /// @note Existing files will be overwritten without warning.
+  ///
+  /// @param filename The path to the file that will be created.
+  ROOTParallelWriter(const std::string& filename);
+
+  /// Create a ROOTParallelWriter to write to a file with the given settings,
+  /// which are used by all writers.
+  ///
+  /// @note Existing files will be overwritten without warning.
+  ///
+  /// @param filename The path to the file that will be created.
+  /// @param options  The compression and TTree settings
+  ROOTParallelWriter(const std::string& filename, const ROOTWriter::Options& options);
+
+  /// ROOTParallelWriter destructor
+  ///
+  /// This also writes the metadata, in case all writers have already been
+  /// finished. Otherwise, an error is printed and the output file will not be
+  /// readable, since the metadata are missing.
+  ~ROOTParallelWriter();
+
+  /// The ROOTParallelWriter is not copy-able
+  ROOTParallelWriter(const ROOTParallelWriter&) = delete;
+  /// The ROOTParallelWriter is not copy-able
+  ROOTParallelWriter& operator=(const ROOTParallelWriter&) = delete;
+
+  /// Get a new writer. Writers are not thread-safe themselves, but different
+  /// writers can be used concurrently.
+  ///
+  /// @note All writers have to be finished (or destroyed) before this
+  /// ROOTParallelWriter is finished.
+  ///
+  /// @returns A ROOTWriter that writes into the output file of this writer
+  ///
+  /// @throws std::runtime_error if this writer has already been finished
+  std::unique_ptr<ROOTWriter> getWriter();
+
+  /// Write the metadata and merge everything into the output file.
+  ///
+  /// @note The destructor will also call this, so letting a ROOTParallelWriter
+  /// go out of scope after all writers are done is also a viable way to write a
+  /// readable file.
+  ///
+  /// @throws std::runtime_error if there are writers that have not yet been
+  /// finished
+  void finish();
+
+private:
+  friend class ROOTWriter;
+
+  /// Register the contents of a category from the first Frame that a writer
+  /// writes. Throws if they are not consistent with what other writers have
+  /// registered before
+  static void registerCategory(detail::ROOTParallelWriterState& state, const std::string& category,
+                               const ROOTWriter::CategoryInfo& catInfo);
+
+  /// Take over the datamodel definitions of a writer that has finished
+  static void writerFinished(detail::ROOTParallelWriterState& state,
+                             const std::vector<std::tuple<std::string, std::string>>& edmDefinitions);
+
+  ROOTWriter::Options m_options{}; ///< The settings for all writers
+  /// The state that is shared with all writers
+  std::shared_ptr<detail::ROOTParallelWriterState> m_state{nullptr};
+};
+
+} // namespace podio
+
+#endif // PODIO_ROOTPARALLELWRITER_H
@@ -8,7 +8,12 @@
 
 #include "TChain.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -32,6 +37,8 @@ namespace detail {
 
 class CollectionBase;
 class CollectionIDTable;
+class CollectionLayout;
+class CollectionBufferPool;
 class GenericParameters;
 struct CollectionReadBuffers;
 
@@ -43,6 +50,45 @@ struct CollectionReadBuffers;
 class ROOTReader {
 
 public:
+  /// The settings for the TTreeCache that is used for reading the entries of
+  /// each category
+  struct CacheOptions {
+    /// The size of the cache in bytes. 0 disables the cache, negative values
+    /// leave the ROOT default untouched (and ignore all other options)
+    std::int64_t cacheSize{-1};
+    /// The collections whose branches are put into the cache. If empty, the
+    /// cache learns the branches that are read during the first learnEntries
+    /// entries, or simply caches all branches if that is 0
+    std::vector<std::string> collections{};
+    /// The number of entries for which the cache learns which branches are read
+    int learnEntries{0};
+    /// Prefetch all the baskets of a cluster at once
+    bool clusterPrefetch{false};
+    /// Fetch the next block of baskets asynchronously while the current one is
+    /// processed. This has to be set before the first entry is read and is a
+    /// global setting for all files that are opened afterwards
+    bool asyncPrefetch{false};
+  };
+
+  /// Counters for judging how effective the TTreeCache of a category is. They
+  /// are accumulated over all files of the chain
+  struct CacheStatistics {
+    std::uint64_t bytesRead{0};       ///< The total number of bytes read from the files
+    std::uint64_t readCalls{0};       ///< The total number of read calls to the files
+    std::uint64_t cachedBytesRead{0}; ///< The number of bytes read by the cache
+    std::uint64_t cachedReadCalls{0}; ///< The number of (vectored) read calls issued by the cache
+    std::uint64_t missedBytesRead{0}; ///< The number of bytes that had to be read bypassing the cache
+    std::uint64_t missedReadCalls{0}; ///< The number of read calls bypassing the cache
+
+    /// The fraction of bytes that have been served by the cache
+    double hitRate() const {
+      const auto total = cachedBytesRead + missedBytesRead;
+      return total ? static_cast<double>(cachedBytesRead) / total : 0;
+    }
+
+    CacheStatistics& operator+=(const CacheStatistics& other);
+  };
+
   /// Create a ROOTReader
   ROOTReader() = default;
   /// Destructor
@@ -71,6 +117,31 @@ public:
   /// @param filenames The filenames of all input files that should be read
   void openFiles(const std::vector<std::string>& filenames);
 
+  /// Open multiple files for reading using an index that has been created via
+  /// createIndex. Only the first file is opened up front to read the meta data,
+  /// the remaining files are only opened once entries are read from them.
+  ///
+  /// @note The same assumptions as for openFiles without an index apply. The
+  /// meta data of the first file are validated against the index.
+  ///
+  /// @param filenames The filenames of all input files that should be read.
+  ///                  All of them have to be present in the index
+  /// @param indexFile The name of the index file
+  ///
+  /// @throws std::runtime_error if a file is not present in the index or if
+  ///         the meta data do not match the ones recorded in the index
+  void openFiles(const std::vector<std::string>& filenames, const std::string& indexFile);
+
+  /// Create an index with the number of entries per category of each file and
+  /// a hash of their meta data, which can be used to open the files without
+  /// having to open all of them up front.
+  ///
+  /// @param filenames The names of the files that should be indexed
+  /// @param indexFile The name of the index file that will be (re-)created
+  ///
+  /// @throws std::runtime_error if the meta data of the files differ
+  static void createIndex(const std::vector<std::string>& filenames, const std::string& indexFile);
+
   /// Read the next data entry for a given category.
   ///
   /// @param name The category name for which to read the next entry
@@ -80,6 +151,54 @@ public:
   ///          Otherwise a nullptr
   std::unique_ptr<podio::ROOTFrameData> readNextEntry(const std::string& name);
 
+  /// Read the next data entry for a given category, but only the passed
+  /// collections (and the collections they are related to).
+  ///
+  /// Only the branches of the requested collections are read. Since the
+  /// targets of their relations are only known after reading them, the
+  /// collections they point to are added to the collections to read for this
+  /// entry, such that all relations can be resolved.
+  ///
+  /// @param name        The category name for which to read the next entry
+  /// @param collsToRead The names of the collections to read. All collections
+  ///                    are read if this is empty
+  ///
+  /// @returns FrameData from which a podio::Frame can be constructed if the
+  ///          category exists and if there are still entries left to read.
+  ///          Otherwise a nullptr
+  ///
+  /// @throws std::invalid_argument if any of the collections is not available
+  std::unique_ptr<podio::ROOTFrameData> readNextEntry(const std::string& name,
+                                                      const std::vector<std::string>& collsToRead);
+
+  /// Read only the parameters of the desired entry for a given category. None
+  /// of the collections are read and the entry that is read next by
+  /// readNextEntry is not changed.
+  ///
+  /// @param name  The category name for which to read the parameters
+  /// @param entry The entry number to read
+  ///
+  /// @returns The GenericParameters of the entry if the category and the
+  ///          desired entry exist. Otherwise an empty optional
+  std::optional<podio::GenericParameters> readParameters(const std::string& name, const unsigned entry);
+
+  /// Get the value of a parameter for all entries of a given category. Only
+  /// the branches storing the parameters of the requested type are read, which
+  /// makes this considerably faster than reading all the entries.
+  ///
+  /// @tparam T The type of the parameter. Either one of the supported types or
+  ///           a std::vector of them
+  ///
+  /// @param name The category name for which to scan the parameter
+  /// @param key  The name of the parameter
+  ///
+  /// @returns The values of the parameter for all entries. The optional is
+  ///          empty for entries in which the parameter is not present
+  ///
+  /// @throws std::runtime_error if the parameters of an entry cannot be read
+  template <typename T, typename = EnableIfValidGenericDataType<T>>
+  std::vector<std::optional<T>> scanParameter(const std::string& name, const std::string& key);
+
   /// Read the desired data entry for a given category.
   ///
   /// @param name  The category name for which to read the next entry
@@ -89,6 +208,96 @@ public:
   ///          category and the desired entry exist. Otherwise a nullptr
   std::unique_ptr<podio::ROOTFrameData> readEntry(const std::string& name, const unsigned entry);
 
+  /// Read the desired data entry for a given category, but only the passed
+  /// collections (and the collections they are related to). See readNextEntry
+  /// for details.
+  ///
+  /// @param name        The category name for which to read the next entry
+  /// @param entry       The entry number to read
+  /// @param collsToRead The names of the collections to read. All collections
+  ///                    are read if this is empty
+  ///
+  /// @returns FrameData from which a podio::Frame can be constructed if the
+  ///          category and the desired entry exist. Otherwise a nullptr
+  ///
+  /// @throws std::invalid_argument if any of the collections is not available
+  std::unique_ptr<podio::ROOTFrameData> readEntry(const std::string& name, const unsigned entry,
+                                                  const std::vector<std::string>& collsToRead);
+
+  /// Re-use the I/O buffers of destroyed Frames for reading further entries.
+  ///
+  /// If enabled, the buffers of all collections of a Frame are put into a pool
+  /// (one per category) when the Frame is destroyed, and subsequent entries
+  /// are read into them. This avoids allocating all the buffers anew for every
+  /// entry. Only affects entries that are read after enabling it.
+  ///
+  /// @param reuse Whether buffers should be re-used or not
+  void setReuseBuffers(bool reuse) {
+    m_reuseBuffers = reuse;
+  }
+
+  /// Only read the branches of a collection once it is requested from a Frame.
+  ///
+  /// If enabled, reading an entry only reads the parameters (and the
+  /// collections that are explicitly requested, see readNextEntry). The
+  /// returned ROOTFrameData remembers the entry and reads the branches of any
+  /// other collection only when it is first requested from the Frame. These
+  /// reads are serialized with all other reads of this reader, so Frames can be
+  /// used on other threads while the reader continues reading entries. Only
+  /// affects entries that are read after enabling it.
+  ///
+  /// @note The reader has to outlive all Frames that have been read lazily
+  /// while collections are still requested from them. Collections that have
+  /// not been read before the reader is destroyed are no longer available.
+  ///
+  /// @param lazy Whether collections should be read lazily or not
+  void setReadLazily(bool lazy) {
+    m_readLazily = lazy;
+  }
+
+  /// Configure the TTreeCache that is used for reading.
+  ///
+  /// The options are applied to all categories, also to the ones that are
+  /// already being read.
+  ///
+  /// @param options The cache settings
+  void setCacheOptions(const CacheOptions& options);
+
+  /// Get the statistics of the TTreeCache for a given category
+  ///
+  /// @param name The name of the category
+  ///
+  /// @returns The statistics accumulated over all files that have been read so
+  ///          far. All counters are 0 for unknown categories
+  CacheStatistics getCacheStatistics(const std::string& name) const;
+
+  /// Create a new reader for the same files that can be used independently of
+  /// this one, e.g. on another thread.
+  ///
+  /// The clone shares all the meta data that have been read from the files
+  /// with this reader, but has its own chains to read from. Hence, creating a
+  /// clone is cheap compared to opening the files again. The settings for
+  /// buffer re-use, lazy reading and caching are taken over. The clone starts
+  /// reading at the first entry for all categories.
+  ///
+  /// @note Creating clones is not thread-safe, i.e. they should be created
+  /// from the thread that uses this reader. This enables ROOTs thread-safety.
+  ///
+  /// @returns A new reader for the same files
+  std::unique_ptr<ROOTReader> clone();
+
+  /// Split the entries of a category into (at most) nRanges consecutive ranges
+  /// of roughly the same size, e.g. to process them in parallel with clones of
+  /// this reader. The ranges are split at the cluster boundaries of the trees,
+  /// such that no cluster has to be read more than once.
+  ///
+  /// @param name    The name of the category
+  /// @param nRanges The desired number of ranges
+  ///
+  /// @returns The ranges as pairs of first entry and one past the last entry.
+  ///          Empty if the category does not exist
+  std::vector<std::pair<unsigned, unsigned>> getEntryRanges(const std::string& name, unsigned nRanges);
+
   /// Get the number of entries for the given name
   ///
   /// @param name The name of the category
@@ -115,14 +324,14 @@ public:
   ///
   /// @returns The high level definition of the datamodel in JSON format
   const std::string_view getDatamodelDefinition(const std::string& name) const {
-    return m_datamodelHolder.getDatamodelDefinition(name);
+    return m_datamodelHolder->getDatamodelDefinition(name);
   }
 
   /// Get all names of the datamodels that are available from this reader
   ///
   /// @returns The names of the datamodels
   std::vector<std::string> getAvailableDatamodels() const {
-    return m_datamodelHolder.getAvailableDatamodels();
+    return m_datamodelHolder->getAvailableDatamodels();
   }
 
 private:
@@ -141,42 +350,132 @@ private:
                                                                                  ///< category
     std::vector<root_utils::CollectionBranches> branches{};                      ///< The branches for this category
     std::shared_ptr<CollectionIDTable> table{nullptr}; ///< The collection ID table for this category
+    std::shared_ptr<const CollectionLayout> layout{nullptr}; ///< The collection layout shared by all Frames of this
+                                                             ///< category
+    std::shared_ptr<CollectionBufferPool> bufferPool{nullptr}; ///< The buffers to re-use (if enabled)
+    std::vector<int> branchTreeNumbers{}; ///< The tree in the chain for which the branches have been set up
+    CacheStatistics cacheStats{};         ///< The cache statistics of the trees that are no longer loaded
+    /// The collection infos as read from the metadata. Shared with all clones
+    std::shared_ptr<const std::vector<root_utils::CollectionWriteInfoT>> collInfo{nullptr};
   };
 
   /// Initialize the passed CategoryInfo by setting up the necessary branches,
   /// collection infos and all necessary meta data to be able to read entries
-  /// with this name
+  /// with this name. The meta data are only read if they are not yet present
+  /// (e.g. from the reader this one has been cloned from)
   void initCategory(CategoryInfo& catInfo, const std::string& name);
 
+  /// Read the meta data (collection id table, collection infos) for the passed
+  /// category
+  void readCategoryMetadata(CategoryInfo& catInfo, const std::string& name);
+
+  /// Read the file level meta data (version, datamodel definitions and available
+  /// categories) from the meta data chain
+  void readFileMetadata();
+
+  /// Compute a hash of all the meta data that are necessary for reading. Reads
+  /// the meta data of all categories if they are not yet present
+  uint64_t getMetadataHash();
+
+  /// Apply the current cache options to the chain of the passed category
+  void setupCache(CategoryInfo& catInfo);
+
+  /// Load the tree containing the entry in the chain of the passed category and
+  /// return the local entry number in that tree. Keeps the cache statistics of
+  /// the previous tree when switching trees
+  static long long loadTree(CategoryInfo& catInfo, unsigned entry);
+
   /// Get the category information for the given name. In case there is no TTree
   /// with contents for the given name this will return a CategoryInfo with an
   /// uninitialized chain (nullptr) member
   CategoryInfo& getCategoryInfo(const std::string& name);
 
   /// Read the parameters for the entry specified in the passed CategoryInfo
-  GenericParameters readEntryParameters(CategoryInfo& catInfo, bool reloadBranches, unsigned int localEntry);
+  GenericParameters readEntryParameters(CategoryInfo& catInfo, unsigned int localEntry);
+
+  /// Make sure that the parameter branches are valid for the currently loaded
+  /// tree of the chain
+  void updateParamBranches(CategoryInfo& catInfo);
+
+  template <typename T>
+  static void readParams(CategoryInfo& catInfo, root_utils::ParamStorage<T>& storage, unsigned int localEntry);
+
+  template <typename T>
+  static void readParams(CategoryInfo& catInfo, podio::GenericParameters& params, unsigned int localEntry);
 
+  /// Read the keys and values of the parameters of type T for the desired entry
+  /// of the given category into the passed storage
+  ///
+  /// @returns false if the category or the entry does not exist
   template <typename T>
-  static void readParams(CategoryInfo& catInfo, podio::GenericParameters& params, bool reloadBranches,
-                         unsigned int localEntry);
+  bool readParamStorage(const std::string& name, unsigned entry, root_utils::ParamStorage<T>& storage);
 
   /// Read the data entry specified in the passed CategoryInfo, and increase the
   /// counter afterwards. In case the requested entry is larger than the
-  /// available number of entries, return a nullptr.
-  std::unique_ptr<podio::ROOTFrameData> readEntry(ROOTReader::CategoryInfo& catInfo);
+  /// available number of entries, return a nullptr. Only the passed collections
+  /// and the targets of their relations are read, unless it is empty
+  std::unique_ptr<podio::ROOTFrameData> readEntry(ROOTReader::CategoryInfo& catInfo,
+                                                  const std::vector<std::string>& collsToRead = {});
+
+  /// Get the indices (in the stored classes) of the collections to which the
+  /// relations in the passed buffers point
+  static std::vector<size_t> getRelationTargets(const CategoryInfo& catInfo,
+                                                const podio::CollectionReadBuffers& buffers);
 
   /// Get / read the buffers at index iColl in the passed category information
-  podio::CollectionReadBuffers getCollectionBuffers(CategoryInfo& catInfo, size_t iColl, bool reloadBranches,
-                                                    unsigned int localEntry);
+  podio::CollectionReadBuffers getCollectionBuffers(CategoryInfo& catInfo, size_t iColl, unsigned int localEntry);
+
+  /// Read the buffers of the collection with the given name for the passed
+  /// entry of the category. Used for the deferred reads of lazily read Frames
+  std::optional<podio::CollectionReadBuffers> readCollectionLazily(CategoryInfo& catInfo, unsigned entry,
+                                                                   const std::string& name);
 
   std::unique_ptr<TChain> m_metaChain{nullptr};                 ///< The metadata tree
+  std::vector<std::string> m_filenames{};                       ///< The names of all input files
   std::unordered_map<std::string, CategoryInfo> m_categories{}; ///< All categories
   std::vector<std::string> m_availCategories{};                 ///< All available categories from this file
 
   podio::version::Version m_fileVersion{0, 0, 0};
-  DatamodelDefinitionHolder m_datamodelHolder{};
+  /// The datamodel definitions. Shared with all clones
+  std::shared_ptr<const DatamodelDefinitionHolder> m_datamodelHolder{std::make_shared<DatamodelDefinitionHolder>()};
+  bool m_reuseBuffers{false};    ///< Whether buffers are re-used
+  bool m_readLazily{false};      ///< Whether collections are only read once they are requested
+  CacheOptions m_cacheOptions{}; ///< The TTreeCache settings
+  /// Serializes all reads from the chains. Lazily read Frames only hold a weak
+  /// reference to it, to notice when the reader is gone
+  std::shared_ptr<std::mutex> m_readMutex{std::make_shared<std::mutex>()};
 };
 
+template <typename T, typename>
+std::vector<std::optional<T>> ROOTReader::scanParameter(const std::string& name, const std::string& key) {
+  const auto nEntries = getEntries(name);
+  std::vector<std::optional<T>> values{};
+  values.reserve(nEntries);
+
+  // Re-use the same storage for all entries to avoid re-allocations
+  root_utils::ParamStorage<detail::GetVectorType<T>> storage{};
+  for (unsigned i = 0; i < nEntries; ++i) {
+    if (!readParamStorage(name, i, storage)) {
+      throw std::runtime_error("Could not read the parameters of entry " + std::to_string(i) + " of category " + name);
+    }
+    const auto it = std::find(storage.keys.begin(), storage.keys.end(), key);
+    if (it == storage.keys.end()) {
+      values.emplace_back(std::nullopt);
+      continue;
+    }
+    const auto& paramValues = storage.values[std::distance(storage.keys.begin(), it)];
+    if constexpr (detail::isVector<T>) {
+      values.emplace_back(paramValues);
+    } else if (paramValues.empty()) {
+      values.emplace_back(std::nullopt);
+    } else {
+      values.emplace_back(paramValues.front());
+    }
+  }
+
+  return values;
+}
+
 } // namespace podio
 
 #endif // PODIO_ROOTREADER_H
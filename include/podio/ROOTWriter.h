@@ -5,8 +5,10 @@
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
 #include "podio/utilities/RootHelpers.h"
 
+#include "Compression.h"
 #include "TFile.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -20,6 +22,10 @@ namespace podio {
 class Frame;
 class CollectionBase;
 class GenericParameters;
+class ROOTParallelWriter;
+namespace detail {
+  struct ROOTParallelWriterState;
+}
 
 /// The ROOTWriter writes podio files into ROOT files using TTrees.
 ///
@@ -30,6 +36,44 @@ class GenericParameters;
 /// Files written with the ROOTWriter can be read with the ROOTReader.
 class ROOTWriter {
 public:
+  /// The settings for writing the TTree of one category. The defaults are the
+  /// ROOT defaults
+  struct CategoryOptions {
+    int basketSize{32000}; ///< The buffer size of the branches in bytes
+    int splitLevel{99};    ///< The split level of the branches
+    /// The auto-flush setting of the TTree. Positive values flush every
+    /// autoFlush entries, negative values every -autoFlush bytes
+    std::int64_t autoFlush{-30000000};
+    /// Split levels for single collections, overriding splitLevel
+    std::unordered_map<std::string, int> collectionSplitLevels{};
+  };
+
+  /// The settings for writing a file
+  struct Options {
+    /// The compression algorithm (ROOT::RCompressionSetting::EAlgorithm)
+    ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm{
+        ROOT::RCompressionSetting::EAlgorithm::kUseGlobal};
+    /// The compression level (0 - 9). Negative values use the ROOT default
+    /// compression settings (and ignore the compression algorithm)
+    int compressionLevel{-1};
+    /// The settings that are used for all categories without specific settings
+    CategoryOptions defaultCategory{};
+    /// The settings for specific categories
+    std::unordered_map<std::string, CategoryOptions> categories{};
+    /// Compress (and flush) the baskets of all branches in parallel, using
+    /// ROOTs implicit multi-threading. Preferably enable that before creating
+    /// the writer (ROOT::EnableImplicitMT). Otherwise the writer enables it,
+    /// but it will not disable it again, since other components might use it
+    /// in the meantime
+    bool parallelCompression{false};
+    /// The number of threads for parallel compression if the writer enables
+    /// implicit multi-threading. 0 uses all available cores
+    unsigned nThreads{0};
+
+    /// The ROOT compression settings for the algorithm and level
+    int compressionSettings() const;
+  };
+
   /// Create a ROOTWriter to write to a file.
   ///
   /// @note Existing files will be overwritten without warning.
@@ -37,6 +81,14 @@ public:
   /// @param filename The path to the file that will be created.
   ROOTWriter(const std::string& filename);
 
+  /// Create a ROOTWriter to write to a file with the given settings.
+  ///
+  /// @note Existing files will be overwritten without warning.
+  ///
+  /// @param filename The path to the file that will be created.
+  /// @param options  The compression and TTree settings
+  ROOTWriter(const std::string& filename, const Options& options);
+
   /// ROOTWriter destructor
   ///
   /// This also takes care of writing all the necessary metadata to read files back again.
@@ -100,6 +152,13 @@ public:
   checkConsistency(const std::vector<std::string>& collsToWrite, const std::string& category) const;
 
 private:
+  friend class ROOTParallelWriter;
+
+  /// Create a ROOTWriter that writes into one of the files of a
+  /// ROOTParallelWriter. Instead of writing the metadata, it passes them on to
+  /// the parallel writer.
+  ROOTWriter(std::shared_ptr<detail::ROOTParallelWriterState> parent, const Options& options);
+
   /// Helper struct to group together all necessary state to write / process a
   /// given category. Created during the first writing of a category
   struct CategoryInfo {
@@ -108,6 +167,7 @@ private:
     std::vector<root_utils::CollectionWriteInfoT> collInfo{}; ///< Collection info for this category
     podio::CollectionIDTable idTable{};                       ///< The collection id table for this category
     std::vector<std::string> collsToWrite{};                  ///< The collections to write for this category
+    const CategoryOptions* options{nullptr};                  ///< The settings for writing this category
 
     // Storage for the keys & values of all the parameters of this category
     // (resp. at least the current entry)
@@ -129,12 +189,18 @@ private:
   /// Fill the parameter keys and values into the CategoryInfo storage
   static void fillParams(CategoryInfo& catInfo, const GenericParameters& params);
 
-  std::unique_ptr<TFile> m_file{nullptr};                       ///< The storage file
+  /// Get the settings for writing the given category
+  const CategoryOptions& getCategoryOptions(const std::string& category) const;
+
+  std::shared_ptr<TFile> m_file{nullptr};                       ///< The storage file
+  Options m_options{};                                          ///< The settings for writing
   std::unordered_map<std::string, CategoryInfo> m_categories{}; ///< All categories
 
   DatamodelDefinitionCollector m_datamodelCollector{};
 
   bool m_finished{false}; ///< Whether writing has been actually done
+  /// The state of the parallel writer that has handed out this writer (if any)
+  std::shared_ptr<detail::ROOTParallelWriterState> m_parent{nullptr};
 };
 
 } // namespace podio
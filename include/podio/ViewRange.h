@@ -0,0 +1,126 @@
+#ifndef PODIO_VIEWRANGE_H
+#define PODIO_VIEWRANGE_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace podio {
+/// A range of lightweight, non-owning views (ViewT) over the Objs (ObjT) of a
+/// collection. Iterating over it yields the views by value, without any
+/// reference counting. The range is only valid as long as no elements are added
+/// to or removed from the collection, while the views themselves are valid for
+/// as long as the collection is alive (and not cleared).
+template <typename ViewT, typename ObjT>
+class ViewRange {
+public:
+  /// Random access iterator creating the views on the fly
+  class Iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = ViewT;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ViewT;
+
+    Iterator() = default;
+    explicit Iterator(ObjT* const* ptr) : m_ptr(ptr) {
+    }
+
+    ViewT operator*() const {
+      return ViewT(*m_ptr);
+    }
+    ViewT operator[](difference_type n) const {
+      return ViewT(m_ptr[n]);
+    }
+
+    Iterator& operator++() {
+      ++m_ptr;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto tmp = *this;
+      ++m_ptr;
+      return tmp;
+    }
+    Iterator& operator--() {
+      --m_ptr;
+      return *this;
+    }
+    Iterator operator--(int) {
+      auto tmp = *this;
+      --m_ptr;
+      return tmp;
+    }
+    Iterator& operator+=(difference_type n) {
+      m_ptr += n;
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+      m_ptr -= n;
+      return *this;
+    }
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.m_ptr - rhs.m_ptr;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return m_ptr == other.m_ptr;
+    }
+    bool operator!=(const Iterator& other) const {
+      return m_ptr != other.m_ptr;
+    }
+    bool operator<(const Iterator& other) const {
+      return m_ptr < other.m_ptr;
+    }
+
+  private:
+    ObjT* const* m_ptr{nullptr};
+  };
+
+  ViewRange() = default;
+  ViewRange(ObjT* const* objs, size_t size) : m_objs(objs), m_size(size) {
+  }
+
+  Iterator begin() const {
+    return Iterator(m_objs);
+  }
+  Iterator end() const {
+    return Iterator(m_objs + m_size);
+  }
+  /// Number of elements in the range
+  size_t size() const {
+    return m_size;
+  }
+  /// Check if the range is empty
+  bool empty() const {
+    return m_size == 0;
+  }
+  /// Indexed access
+  ViewT operator[](size_t i) const {
+    return ViewT(m_objs[i]);
+  }
+  /// Indexed access with range check
+  ViewT at(size_t i) const {
+    if (i < m_size) {
+      return ViewT(m_objs[i]);
+    }
+    throw std::out_of_range("index out of bounds for ViewRange");
+  }
+
+private:
+  ObjT* const* m_objs{nullptr};
+  size_t m_size{0};
+};
+} // namespace podio
+
+#endif // PODIO_VIEWRANGE_H
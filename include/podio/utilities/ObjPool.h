@@ -0,0 +1,157 @@
+#ifndef PODIO_UTILITIES_OBJPOOL_H
+#define PODIO_UTILITIES_OBJPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace podio::utils {
+
+/// Block based storage for the Obj instances of a collection.
+///
+/// Objects are constructed in place in large, contiguous blocks of memory
+/// instead of being allocated individually on the heap. Once constructed an
+/// object never moves, i.e. pointers to it stay valid until the pool is
+/// cleared or destroyed, which is what the handle classes rely on. Growing the
+/// pool never relocates existing objects, instead a new block is started that
+/// is at least as large as all previous blocks combined. Hence, filling a pool
+/// with N objects needs O(log N) allocations and only a single one if the final
+/// size is known up front and passed to reserve.
+template <typename T>
+class ObjPool {
+  /// A chunk of raw memory with room for capacity objects, of which the first
+  /// size are constructed
+  struct Block {
+    T* objs{nullptr};
+    size_t size{0};
+    size_t capacity{0};
+  };
+
+public:
+  /// The size of the first block if nothing has been reserved beforehand
+  constexpr static size_t minBlockSize = 16;
+
+  ObjPool() = default;
+  ~ObjPool() {
+    releaseBlocks(0);
+  }
+
+  /// The pool owns the objects and is hence not copyable
+  ObjPool(const ObjPool&) = delete;
+  /// The pool owns the objects and is hence not copyable
+  ObjPool& operator=(const ObjPool&) = delete;
+
+  /// Move constructor. All objects stay at their current location
+  ObjPool(ObjPool&& other) noexcept : m_blocks(std::move(other.m_blocks)), m_size(other.m_size) {
+    other.m_blocks.clear();
+    other.m_size = 0;
+  }
+
+  /// Move assignment. All objects of other stay at their current location
+  ObjPool& operator=(ObjPool&& other) noexcept {
+    if (this != &other) {
+      releaseBlocks(0);
+      m_blocks = std::move(other.m_blocks);
+      m_size = other.m_size;
+      other.m_blocks.clear();
+      other.m_size = 0;
+    }
+    return *this;
+  }
+
+  /// Make sure that at least n more objects can be constructed without any
+  /// further allocation. All of these will end up in the same block.
+  void reserve(size_t n) {
+    if (freeSlots() < n) {
+      addBlock(std::max(n, m_size));
+    }
+  }
+
+  /// Construct a new object from the passed arguments and return a pointer to
+  /// it. The pool retains ownership of the object.
+  template <typename... Args>
+  T* emplace(Args&&... args) {
+    if (freeSlots() == 0) {
+      addBlock(std::max(minBlockSize, m_size));
+    }
+    auto& block = m_blocks.back();
+    auto* obj = ::new (static_cast<void*>(block.objs + block.size)) T(std::forward<Args>(args)...);
+    ++block.size;
+    ++m_size;
+    return obj;
+  }
+
+  /// Check whether the passed object lives in this pool
+  bool owns(const T* obj) const {
+    const auto less = std::less<const T*>{};
+    return std::any_of(m_blocks.begin(), m_blocks.end(), [&](const Block& block) {
+      return !less(obj, block.objs) && less(obj, block.objs + block.size);
+    });
+  }
+
+  /// Whether all objects live in one contiguous block, in the order in which
+  /// they have been emplaced
+  bool contiguous() const {
+    return std::count_if(m_blocks.begin(), m_blocks.end(), [](const Block& block) { return block.size > 0; }) <= 1;
+  }
+
+  /// The number of objects that currently live in the pool
+  size_t size() const {
+    return m_size;
+  }
+
+  /// Destroy all objects. The largest block is kept around (empty) to serve
+  /// future emplacements without having to allocate again.
+  void clear() {
+    if (m_blocks.empty()) {
+      return;
+    }
+    const auto largest = std::max_element(m_blocks.begin(), m_blocks.end(),
+                                          [](const Block& a, const Block& b) { return a.capacity < b.capacity; });
+    std::iter_swap(largest, m_blocks.begin());
+    releaseBlocks(1);
+    destroyObjects(m_blocks.front());
+    m_size = 0;
+  }
+
+private:
+  size_t freeSlots() const {
+    return m_blocks.empty() ? 0 : m_blocks.back().capacity - m_blocks.back().size;
+  }
+
+  void addBlock(size_t capacity) {
+    // Drop a trailing empty block that is too small instead of keeping it around
+    if (!m_blocks.empty() && m_blocks.back().size == 0) {
+      std::allocator<T>{}.deallocate(m_blocks.back().objs, m_blocks.back().capacity);
+      m_blocks.pop_back();
+    }
+    m_blocks.push_back({std::allocator<T>{}.allocate(capacity), 0, capacity});
+  }
+
+  static void destroyObjects(Block& block) {
+    for (size_t i = 0; i < block.size; ++i) {
+      block.objs[i].~T();
+    }
+    block.size = 0;
+  }
+
+  /// Destroy all objects and deallocate all blocks starting from the given one
+  void releaseBlocks(size_t first) {
+    for (size_t i = first; i < m_blocks.size(); ++i) {
+      destroyObjects(m_blocks[i]);
+      std::allocator<T>{}.deallocate(m_blocks[i].objs, m_blocks[i].capacity);
+    }
+    m_blocks.resize(std::min(first, m_blocks.size()));
+  }
+
+  std::vector<Block> m_blocks{}; ///< The blocks, the last one is the one that is currently filled
+  size_t m_size{0};              ///< The total number of objects in all blocks
+};
+
+} // namespace podio::utils
+
+#endif // PODIO_UTILITIES_OBJPOOL_H
@@ -44,6 +44,8 @@ namespace root_utils {
     std::vector<TBranch*> vecs{};
     std::vector<std::string> refNames{}; ///< The names of the relation branches
     std::vector<std::string> vecNames{}; ///< The names of the vector member branches
+    void* dataPtr{nullptr};              ///< The data buffer when reading into existing buffers
+    std::vector<void*> vecPtrs{};        ///< The vector member buffers when reading into existing buffers
   };
 
   /// Pair of keys and values for one type of the ones that can be stored in
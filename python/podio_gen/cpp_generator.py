@@ -175,6 +175,7 @@ class CPPClassGenerator(ClassGeneratorBaseMixin):
         self._fill_templates("Data", datatype)
         self._fill_templates("Object", datatype)
         self._fill_templates("MutableObject", datatype)
+        self._fill_templates("View", datatype)
         self._fill_templates("Obj", datatype)
         self._fill_templates("Collection", datatype)
         self._fill_templates("CollectionData", datatype)
@@ -195,7 +196,7 @@ class CPPClassGenerator(ClassGeneratorBaseMixin):
         """Print a summary report about the generated code"""
         if not self.verbose:
             return
-        nclasses = 5 * len(self.datamodel.datatypes) + len(self.datamodel.components)
+        nclasses = 6 * len(self.datamodel.datatypes) + len(self.datamodel.components)
         text = REPORT_TEXT.format(
             yamlfile=self.yamlfile, nclasses=nclasses, installdir=self.install_dir
         )
@@ -318,6 +319,15 @@ class CPPClassGenerator(ClassGeneratorBaseMixin):
         if datatype["VectorMembers"]:
             includes_cc.add("#include <numeric>")
 
+        # Batch operations are generated for all arithmetic members, in-place
+        # transformations only for the floating point ones
+        datatype["NumericMembers"] = [
+            m for m in datatype["Members"] if m.is_builtin and m.full_type != "bool"
+        ]
+        datatype["FloatingPointMembers"] = [
+            m for m in datatype["NumericMembers"] if m.full_type in ("float", "double")
+        ]
+
         datatype["includes_coll_cc"] = self._sort_includes(includes_cc)
         datatype["includes_coll_data"] = self._sort_includes(includes)
 
@@ -206,6 +206,7 @@ class ClassGeneratorBaseMixin:
                 "SIOBlock": "SIOBlock",
                 "Collection": "Collection",
                 "CollectionData": "CollectionData",
+                "View": "View",
                 "MutableStruct": "Struct",
             }
 
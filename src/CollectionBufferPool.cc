@@ -0,0 +1,50 @@
+#include "podio/CollectionBufferPool.h"
+
+namespace podio {
+
+CollectionBufferPool::~CollectionBufferPool() {
+  for (auto& [_, buffers] : m_buffers) {
+    for (auto& buffer : buffers) {
+      buffer.deleteBuffers(buffer);
+    }
+  }
+}
+
+std::optional<podio::CollectionReadBuffers> CollectionBufferPool::take(const std::string& name,
+                                                                         std::string_view type,
+                                                                         SchemaVersionT schemaVersion,
+                                                                         bool isSubsetColl) {
+  auto buffer = podio::CollectionReadBuffers{};
+  {
+    std::lock_guard lock{m_mutex};
+    auto it = m_buffers.find(name);
+    if (it == m_buffers.end() || it->second.empty()) {
+      return std::nullopt;
+    }
+    buffer = std::move(it->second.back());
+    it->second.pop_back();
+  }
+
+  // Buffers that do not fit (anymore) cannot be re-used
+  if (buffer.type != type || buffer.schemaVersion != schemaVersion || (buffer.data == nullptr) != isSubsetColl) {
+    buffer.deleteBuffers(buffer);
+    return std::nullopt;
+  }
+  return buffer;
+}
+
+void CollectionBufferPool::put(const std::string& name, podio::CollectionReadBuffers buffers) {
+  std::lock_guard lock{m_mutex};
+  m_buffers[name].emplace_back(std::move(buffers));
+}
+
+size_t CollectionBufferPool::size() const {
+  std::lock_guard lock{m_mutex};
+  size_t size = 0;
+  for (const auto& [_, buffers] : m_buffers) {
+    size += buffers.size();
+  }
+  return size;
+}
+
+} // namespace podio
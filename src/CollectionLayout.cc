@@ -0,0 +1,40 @@
+#include "podio/CollectionLayout.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace podio {
+
+CollectionLayout::CollectionLayout(const podio::CollectionIDTable& idTable) {
+  const auto& ids = idTable.ids();
+  const auto& names = idTable.names();
+
+  std::vector<size_t> order(ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&ids](size_t i, size_t j) { return ids[i] < ids[j]; });
+
+  m_collectionIDs.reserve(ids.size());
+  m_names.reserve(ids.size());
+  for (const auto i : order) {
+    m_collectionIDs.push_back(ids[i]);
+    m_names.push_back(names[i]);
+  }
+}
+
+std::optional<size_t> CollectionLayout::slot(uint32_t collectionID) const {
+  const auto it = std::lower_bound(m_collectionIDs.begin(), m_collectionIDs.end(), collectionID);
+  if (it == m_collectionIDs.end() || *it != collectionID) {
+    return std::nullopt;
+  }
+  return std::distance(m_collectionIDs.begin(), it);
+}
+
+std::optional<size_t> CollectionLayout::slot(const std::string& name) const {
+  const auto it = std::find(m_names.begin(), m_names.end(), name);
+  if (it == m_names.end()) {
+    return std::nullopt;
+  }
+  return std::distance(m_names.begin(), it);
+}
+
+} // namespace podio
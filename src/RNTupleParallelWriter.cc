@@ -0,0 +1,148 @@
+#include "podio/RNTupleParallelWriter.h"
+
+#include "rootUtils.h"
+
+#include "TROOT.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace podio {
+
+RNTupleParallelWriter::RNTupleParallelWriter(const std::string& filename) :
+    RNTupleParallelWriter(filename, RNTupleWriter::Options{}) {
+}
+
+RNTupleParallelWriter::RNTupleParallelWriter(const std::string& filename, const RNTupleWriter::Options& options) :
+    m_state(std::make_shared<detail::RNTupleParallelWriterState>()) {
+  // The writers are meant to be used on different threads
+  ROOT::EnableThreadSafety();
+  m_state->options = options;
+  // Filling from several threads requires buffering the clusters
+  m_state->options.useBufferedWrite = true;
+  m_state->file = std::make_unique<TFile>(filename.c_str(), "RECREATE", "data file");
+
+  // Implicit multi-threading is global state that other components might rely
+  // on as well, so it is only ever enabled here, never disabled
+  if (options.parallelCompression && !ROOT::IsImplicitMTEnabled()) {
+    ROOT::EnableImplicitMT(options.nThreads);
+  }
+}
+
+RNTupleParallelWriter::~RNTupleParallelWriter() {
+  {
+    std::lock_guard lock{m_state->mutex};
+    if (m_state->finished) {
+      return;
+    }
+    // Writers that are still active would fill RNTuples that are already
+    // committed. They keep the RNTuples alive, so they can still be finished
+    // safely, but the metadata will be missing from the file
+    if (m_state->activeWriters > 0) {
+      std::cerr << "ERROR: The RNTupleParallelWriter is destroyed while " << m_state->activeWriters
+                << " of its writers have not yet been finished. The output file will not be readable" << std::endl;
+      return;
+    }
+  }
+  finish();
+}
+
+std::unique_ptr<RNTupleWriter> RNTupleParallelWriter::getWriter() {
+  std::lock_guard lock{m_state->mutex};
+  if (m_state->finished) {
+    throw std::runtime_error("Cannot get a new writer from an already finished RNTupleParallelWriter");
+  }
+
+  m_state->activeWriters++;
+  // The constructor is private, so make_unique is not an option
+  return std::unique_ptr<RNTupleWriter>(new RNTupleWriter(m_state, m_state->options));
+}
+
+std::shared_ptr<ROOT::Experimental::RNTupleFillContext>
+RNTupleParallelWriter::registerCategory(detail::RNTupleParallelWriterState& state, const std::string& category,
+                                        const RNTupleWriter::CategoryInfo& catInfo,
+                                        std::unique_ptr<ROOT::Experimental::RNTupleModel> model) {
+  std::lock_guard lock{state.mutex};
+  auto [it, inserted] = state.categories.try_emplace(category);
+  auto& info = it->second;
+  if (inserted) {
+    info.ids = catInfo.ids;
+    info.names = catInfo.names;
+    info.types = catInfo.types;
+    info.subsetCollections = catInfo.subsetCollections;
+    info.schemaVersions = catInfo.schemaVersions;
+    std::lock_guard fileLock{state.fileMutex};
+    state.writers[category] = ROOT::Experimental::RNTupleParallelWriter::Append(
+        std::move(model), category, *state.file, state.options.writeOptions());
+  } else if (!root_utils::checkConsistentColls(info.names, catInfo.names)) {
+    throw std::runtime_error("Trying to write category '" + category + "' with inconsistent collection content. " +
+                             root_utils::getInconsistentCollsMsg(info.names, catInfo.names));
+  }
+
+  return state.writers[category]->CreateFillContext();
+}
+
+void RNTupleParallelWriter::fill(detail::RNTupleParallelWriterState& state,
+                                 ROOT::Experimental::RNTupleFillContext& fillContext,
+                                 ROOT::Experimental::REntry& entry) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 34, 0)
+  // Filling and compressing the pages only involves this fill context, only
+  // writing the cluster goes to the file
+  ROOT::Experimental::RNTupleFillStatus status;
+  fillContext.FillNoFlush(entry, status);
+  if (status.ShouldFlushCluster()) {
+    fillContext.FlushColumns();
+    std::lock_guard lock{state.fileMutex};
+    fillContext.FlushCluster();
+  }
+#else
+  // Every fill can flush a cluster to the file
+  std::lock_guard lock{state.fileMutex};
+  fillContext.Fill(entry);
+#endif
+}
+
+void RNTupleParallelWriter::releaseFillContext(detail::RNTupleParallelWriterState& state,
+                                               std::shared_ptr<ROOT::Experimental::RNTupleFillContext>& fillContext) {
+  std::lock_guard lock{state.fileMutex};
+  fillContext.reset();
+}
+
+void RNTupleParallelWriter::writerFinished(detail::RNTupleParallelWriterState& state,
+                                           const std::vector<std::tuple<std::string, std::string>>& edmDefinitions) {
+  std::lock_guard lock{state.mutex};
+  for (const auto& edmDef : edmDefinitions) {
+    const auto& name = std::get<0>(edmDef);
+    if (std::find_if(state.edmDefinitions.begin(), state.edmDefinitions.end(),
+                     [&name](const auto& def) { return std::get<0>(def) == name; }) == state.edmDefinitions.end()) {
+      state.edmDefinitions.push_back(edmDef);
+    }
+  }
+  state.activeWriters--;
+}
+
+void RNTupleParallelWriter::finish() {
+  std::lock_guard lock{m_state->mutex};
+  if (m_state->finished) {
+    return;
+  }
+  if (m_state->activeWriters > 0) {
+    throw std::runtime_error("Cannot finish a RNTupleParallelWriter while " + std::to_string(m_state->activeWriters) +
+                             " of its writers have not yet been finished");
+  }
+
+  // Destroying the writers commits the RNTuples of all categories. All fill
+  // contexts are gone with the writers that have been finished
+  std::lock_guard fileLock{m_state->fileMutex};
+  m_state->writers.clear();
+
+  RNTupleWriter::writeMetadata(*m_state->file, std::move(m_state->edmDefinitions), m_state->categories,
+                               m_state->options);
+  m_state->file->Write();
+  m_state->file->Close();
+
+  m_state->finished = true;
+}
+
+} // namespace podio
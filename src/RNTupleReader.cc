@@ -3,66 +3,284 @@
 #include "podio/CollectionBufferFactory.h"
 #include "podio/CollectionBuffers.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionLayout.h"
 #include "podio/DatamodelRegistry.h"
 #include "podio/GenericParameters.h"
+#include "podio/ObjectID.h"
 #include "rootUtils.h"
 
 #include <ROOT/RError.hxx>
 
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <utility>
 
 namespace podio {
 
 template <typename T>
-void RNTupleReader::readParams(const std::string& name, unsigned entNum, GenericParameters& params) {
-  auto keyView = m_readers[name][0]->GetView<std::vector<std::string>>(root_utils::getGPKeyName<T>());
-  auto valueView = m_readers[name][0]->GetView<std::vector<std::vector<T>>>(root_utils::getGPValueName<T>());
-
-  params.loadFrom(keyView(entNum), valueView(entNum));
+void RNTupleReader::readParams(AllParamFields& paramFields, GenericParameters& params) {
+  // The values are read into the same fields again for the next entry, so they
+  // can simply be moved out
+  auto& [keys, values] = std::get<ParamFields<T>>(paramFields);
+  params.loadFrom(std::move(*keys), std::move(*values));
 }
 
-GenericParameters RNTupleReader::readEventMetaData(const std::string& name, unsigned entNum) {
+GenericParameters RNTupleReader::readEventMetaData(AllParamFields& paramFields) {
   GenericParameters params;
 
-  readParams<int>(name, entNum, params);
-  readParams<float>(name, entNum, params);
-  readParams<double>(name, entNum, params);
-  readParams<std::string>(name, entNum, params);
+  readParams<int>(paramFields, params);
+  readParams<float>(paramFields, params);
+  readParams<double>(paramFields, params);
+  readParams<std::string>(paramFields, params);
 
   return params;
 }
 
-bool RNTupleReader::initCategory(const std::string& category) {
-  if (std::find(m_availableCategories.begin(), m_availableCategories.end(), category) == m_availableCategories.end()) {
-    return false;
+template <typename T>
+void bindParamFields(ROOT::Experimental::REntry& entry, std::vector<std::string>*& keys,
+                     std::vector<std::vector<T>>*& values) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
+  keys = entry.GetPtr<std::vector<std::string>>(root_utils::getGPKeyName<T>()).get();
+  values = entry.GetPtr<std::vector<std::vector<T>>>(root_utils::getGPValueName<T>()).get();
+#else
+  keys = entry.Get<std::vector<std::string>>(root_utils::getGPKeyName<T>());
+  values = entry.Get<std::vector<std::vector<T>>>(root_utils::getGPValueName<T>());
+#endif
+}
+
+void RNTupleReader::createReusableEntry(ROOT::Experimental::RNTupleReader& reader, ReusableEntry& reusableEntry,
+                                        bool withParams) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
+  // We need to create a non-bare entry here, because the parameters are read
+  // into the values that are owned by the entry. All the collection fields
+  // are bound to the buffers anew for every entry in any case.
+  reusableEntry.entry = reader.GetModel().CreateEntry();
+#else
+  reusableEntry.entry = reader.GetModel()->GetDefaultEntry();
+#endif
+  if (withParams) {
+    auto& [intParams, floatParams, doubleParams, stringParams] = reusableEntry.params;
+    bindParamFields(*reusableEntry.entry, intParams.keys, intParams.values);
+    bindParamFields(*reusableEntry.entry, floatParams.keys, floatParams.values);
+    bindParamFields(*reusableEntry.entry, doubleParams.keys, doubleParams.values);
+    bindParamFields(*reusableEntry.entry, stringParams.keys, stringParams.values);
+  }
+}
+
+RNTupleReader::ReusableEntry& RNTupleReader::getReusableEntry(const std::string& category, size_t iFile) {
+  auto& entries = m_reusableEntries[category];
+  if (entries.size() <= iFile) {
+    entries.resize(iFile + 1);
+  }
+  auto& reusableEntry = entries[iFile];
+  if (!reusableEntry.entry) {
+    createReusableEntry(*m_readers[category][iFile], reusableEntry, true);
+  }
+  return reusableEntry;
+}
+
+/// Call func with the name of each field of a collection and the pointer to
+/// the buffer that is read from it
+template <typename FieldsT, typename FuncT>
+void forEachCollectionField(const FieldsT& fields, podio::CollectionReadBuffers& buffers, FuncT&& func) {
+  // Only the buffers that have been created by the factory are bound to the
+  // fields, everything else has been set up already
+  if (!fields.data.empty()) {
+    func(fields.data, buffers.data);
+  }
+  for (size_t j = 0; j < fields.refs.size(); ++j) {
+    func(fields.refs[j], static_cast<void*>(buffers.references->at(j).get()));
+  }
+  for (size_t j = 0; j < fields.vecMems.size(); ++j) {
+    func(fields.vecMems[j], buffers.vectorMembers->at(j).second);
+  }
+}
+
+std::optional<podio::CollectionReadBuffers> RNTupleReader::createCollectionBuffers(const std::string& category,
+                                                                                   size_t iColl) {
+  const auto& collInfo = m_collectionInfo[category];
+  const auto& bufferFactory = podio::CollectionBufferFactory::instance();
+  auto maybeBuffers = bufferFactory.createBuffers(collInfo.type[iColl], collInfo.schemaVersion[iColl],
+                                                  collInfo.isSubsetCollection[iColl]);
+
+  if (!maybeBuffers) {
+    std::cout << "WARNING: Buffers couldn't be created for collection " << collInfo.name[iColl] << " of type "
+              << collInfo.type[iColl] << " and schema version " << collInfo.schemaVersion[iColl] << std::endl;
+  }
+  return maybeBuffers;
+}
+
+std::optional<podio::CollectionReadBuffers>
+RNTupleReader::bindCollectionBuffers(ROOT::Experimental::REntry& entry, const std::string& category, size_t iColl) {
+  auto maybeBuffers = createCollectionBuffers(category, iColl);
+  if (!maybeBuffers) {
+    return std::nullopt;
+  }
+
+  forEachCollectionField(m_collectionFields[category][iColl], *maybeBuffers,
+                         [&entry](const std::string& fieldName, void* buffer) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
+                           entry.BindRawPtr(fieldName, buffer);
+#else
+                           entry.CaptureValueUnsafe(fieldName, buffer);
+#endif
+                         });
+
+  return maybeBuffers;
+}
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+template <typename T>
+void bindParamViews(ROOT::Experimental::RNTupleReader& reader,
+                    std::vector<ROOT::Experimental::RNTupleView<void>>& views, std::vector<std::string>*& keys,
+                    std::vector<std::vector<T>>*& values) {
+  const auto& keyView = views.emplace_back(reader.GetView<void>(root_utils::getGPKeyName<T>()));
+  keys = keyView.GetValue().template GetPtr<std::vector<std::string>>().get();
+  const auto& valueView = views.emplace_back(reader.GetView<void>(root_utils::getGPValueName<T>()));
+  values = valueView.GetValue().template GetPtr<std::vector<std::vector<T>>>().get();
+}
+
+RNTupleReader::ProjectedViews& RNTupleReader::getProjectedViews(const std::string& category, size_t iFile) {
+  auto& fileViews = m_projectedViews[category];
+  if (fileViews.size() <= iFile) {
+    fileViews.resize(iFile + 1);
+  }
+  auto& views = fileViews[iFile];
+  if (views.params.empty()) {
+    auto& reader = *m_readers[category][iFile];
+    views.collections.resize(m_collectionFields[category].size());
+    // One view for the keys and one for the values of each parameter type
+    views.params.reserve(8);
+    auto& [intParams, floatParams, doubleParams, stringParams] = views.paramFields;
+    bindParamViews(reader, views.params, intParams.keys, intParams.values);
+    bindParamViews(reader, views.params, floatParams.keys, floatParams.values);
+    bindParamViews(reader, views.params, doubleParams.keys, doubleParams.values);
+    bindParamViews(reader, views.params, stringParams.keys, stringParams.values);
+  }
+  return views;
+}
+
+std::optional<podio::CollectionReadBuffers> RNTupleReader::readCollectionViews(const std::string& category,
+                                                                               size_t iFile, unsigned localEntry,
+                                                                               size_t iColl) {
+  auto maybeBuffers = createCollectionBuffers(category, iColl);
+  if (!maybeBuffers) {
+    return std::nullopt;
+  }
+
+  // The views are only created the first time this collection is read from
+  // this file, afterwards they only have to be bound to the new buffers
+  auto& reader = *m_readers[category][iFile];
+  auto& collViews = getProjectedViews(category, iFile).collections[iColl];
+  size_t iField = 0;
+  forEachCollectionField(m_collectionFields[category][iColl], *maybeBuffers,
+                         [&](const std::string& fieldName, void* buffer) {
+                           if (collViews.size() <= iField) {
+                             collViews.emplace_back(reader.GetView<void>(fieldName));
+                           }
+                           auto& view = collViews[iField++];
+                           view.BindRawPtr(buffer);
+                           view(localEntry);
+                         });
+
+  return maybeBuffers;
+}
+#endif
+
+std::vector<size_t> RNTupleReader::getRelationTargets(const std::string& category,
+                                                      const podio::CollectionReadBuffers& buffers) {
+  const auto& collIDs = m_collectionInfo[category].id;
+  std::vector<size_t> targets{};
+  if (buffers.references) {
+    for (const auto& refs : *buffers.references) {
+      for (const auto& id : *refs) {
+        if (id.index == podio::ObjectID::invalid) {
+          continue;
+        }
+        // The ObjectIDs of one relation usually point to very few collections,
+        // so this is cheap
+        const auto it = std::find(collIDs.begin(), collIDs.end(), id.collectionID);
+        if (it != collIDs.end()) {
+          const auto target = static_cast<size_t>(std::distance(collIDs.begin(), it));
+          if (std::find(targets.begin(), targets.end(), target) == targets.end()) {
+            targets.push_back(target);
+          }
+        }
+      }
+    }
   }
-  // Assume that the metadata is the same in all files
-  auto filename = m_filenames[0];
+  return targets;
+}
+
+RNTupleReader::CollectionInfo RNTupleReader::readCollectionInfo(ROOT::Experimental::RNTupleReader& metadata,
+                                                                const std::string& category) {
+  CollectionInfo collInfo{};
+
+  auto id = metadata.GetView<std::vector<unsigned int>>(root_utils::idTableName(category));
+  collInfo.id = id(0);
 
-  auto id = m_metadata_readers[filename]->GetView<std::vector<unsigned int>>(root_utils::idTableName(category));
-  m_collectionInfo[category].id = id(0);
+  auto collectionName = metadata.GetView<std::vector<std::string>>(root_utils::collectionName(category));
+  collInfo.name = collectionName(0);
 
-  auto collectionName =
-      m_metadata_readers[filename]->GetView<std::vector<std::string>>(root_utils::collectionName(category));
-  m_collectionInfo[category].name = collectionName(0);
+  auto collectionType = metadata.GetView<std::vector<std::string>>(root_utils::collInfoName(category));
+  collInfo.type = collectionType(0);
 
-  auto collectionType =
-      m_metadata_readers[filename]->GetView<std::vector<std::string>>(root_utils::collInfoName(category));
-  m_collectionInfo[category].type = collectionType(0);
+  auto subsetCollection = metadata.GetView<std::vector<short>>(root_utils::subsetCollection(category));
+  collInfo.isSubsetCollection = subsetCollection(0);
 
-  auto subsetCollection =
-      m_metadata_readers[filename]->GetView<std::vector<short>>(root_utils::subsetCollection(category));
-  m_collectionInfo[category].isSubsetCollection = subsetCollection(0);
+  auto schemaVersion = metadata.GetView<std::vector<SchemaVersionT>>("schemaVersion_" + category);
+  collInfo.schemaVersion = schemaVersion(0);
 
-  auto schemaVersion = m_metadata_readers[filename]->GetView<std::vector<SchemaVersionT>>("schemaVersion_" + category);
-  m_collectionInfo[category].schemaVersion = schemaVersion(0);
+  return collInfo;
+}
+
+bool RNTupleReader::initCategory(const std::string& category) {
+  if (std::find(m_availableCategories.begin(), m_availableCategories.end(), category) == m_availableCategories.end()) {
+    return false;
+  }
+  // The metadata of the other files are checked against the ones from the
+  // first file once they are opened
+  m_collectionInfo[category] = readCollectionInfo(getMetadataReader(m_filenames[0]), category);
+
+  // Determine the fields of all collections only once, since they are the same
+  // for all entries
+  const auto& collInfo = m_collectionInfo[category];
+  auto& collFields = m_collectionFields[category];
+  collFields.clear();
+  collFields.reserve(collInfo.name.size());
+  for (size_t i = 0; i < collInfo.name.size(); ++i) {
+    auto& fields = collFields.emplace_back();
+    const auto& collName = collInfo.name[i];
+    if (collInfo.isSubsetCollection[i]) {
+      fields.refs.emplace_back(root_utils::subsetBranch(collName));
+      continue;
+    }
+    fields.data = collName;
+    const auto relVecNames = podio::DatamodelRegistry::instance().getRelationNames(collInfo.type[i]);
+    for (const auto& relName : relVecNames.relations) {
+      fields.refs.emplace_back(root_utils::refBranch(collName, relName));
+    }
+    for (const auto& vecName : relVecNames.vectorMembers) {
+      fields.vecMems.emplace_back(root_utils::vecBranch(collName, vecName));
+    }
+  }
 
   m_idTables[category] =
       std::make_shared<CollectionIDTable>(m_collectionInfo[category].id, m_collectionInfo[category].name);
+  m_collectionLayouts[category] = std::make_shared<const CollectionLayout>(*m_idTables[category]);
 
   return true;
 }
 
+ROOT::Experimental::RNTupleReader& RNTupleReader::getMetadataReader(const std::string& filename) {
+  auto& metadata = m_metadata_readers[filename];
+  if (!metadata) {
+    metadata = ROOT::Experimental::RNTupleReader::Open(root_utils::metaTreeName, filename);
+  }
+  return *metadata;
+}
+
 void RNTupleReader::openFile(const std::string& filename) {
   openFiles({filename});
 }
@@ -70,11 +288,6 @@ void RNTupleReader::openFile(const std::string& filename) {
 void RNTupleReader::openFiles(const std::vector<std::string>& filenames) {
 
   m_filenames.insert(m_filenames.end(), filenames.begin(), filenames.end());
-  for (auto& filename : filenames) {
-    if (m_metadata_readers.find(filename) == m_metadata_readers.end()) {
-      m_metadata_readers[filename] = ROOT::Experimental::RNTupleReader::Open(root_utils::metaTreeName, filename);
-    }
-  }
 
   m_metadata = ROOT::Experimental::RNTupleReader::Open(root_utils::metaTreeName, filenames[0]);
 
@@ -91,19 +304,64 @@ void RNTupleReader::openFiles(const std::vector<std::string>& filenames) {
   m_availableCategories = availableCategoriesField(0);
 }
 
-unsigned RNTupleReader::getEntries(const std::string& name) {
-  if (m_readers.find(name) == m_readers.end()) {
-    for (auto& filename : m_filenames) {
-      try {
-        m_readers[name].emplace_back(ROOT::Experimental::RNTupleReader::Open(name, filename));
-      } catch (const ROOT::Experimental::RException& e) {
-        std::cout << "Category " << name << " not found in file " << filename << std::endl;
-      }
+bool RNTupleReader::openNextReader(const std::string& category) {
+  auto& readers = m_readers[category];
+  const auto iFile = readers.size();
+  if (iFile >= m_filenames.size()) {
+    return false;
+  }
+  const auto& filename = m_filenames[iFile];
+
+  auto& entries = m_readerEntries[category];
+  const auto prevEntries = entries.empty() ? 0u : entries.back();
+  std::unique_ptr<ROOT::Experimental::RNTupleReader> reader{nullptr};
+  try {
+    reader = ROOT::Experimental::RNTupleReader::Open(category, filename);
+  } catch (const ROOT::Experimental::RException& e) {
+    std::cout << "Category " << category << " not found in file " << filename << std::endl;
+    readers.emplace_back(nullptr);
+    entries.push_back(prevEntries);
+    return true;
+  }
+
+  // Make sure that the contents of all files are the same as the ones of the
+  // first file, as only those are used to create the buffers for reading.
+  // Files without this category have no metadata for it and are skipped above
+  if (iFile > 0) {
+    const auto hasCollInfo = m_collectionInfo.find(category) != m_collectionInfo.end() || initCategory(category);
+    if (hasCollInfo && readCollectionInfo(getMetadataReader(filename), category) != m_collectionInfo[category]) {
+      throw std::runtime_error("The collections of category " + category + " in file " + filename +
+                               " do not match the ones in file " + m_filenames[0]);
+    }
+  }
+
+  entries.push_back(prevEntries + reader->GetNEntries());
+  readers.emplace_back(std::move(reader));
+  return true;
+}
+
+std::optional<std::pair<size_t, unsigned>> RNTupleReader::getFileAndEntry(const std::string& category,
+                                                                         unsigned entNum) {
+  auto& entries = m_readerEntries[category];
+  while (entries.empty() || entries.back() <= entNum) {
+    if (!openNextReader(category)) {
+      return std::nullopt;
     }
-    m_totalEntries[name] = std::accumulate(m_readers[name].begin(), m_readers[name].end(), 0,
-                                           [](int total, auto& reader) { return total + reader->GetNEntries(); });
   }
-  return m_totalEntries[name];
+
+  // The first file for which the accumulated number of entries is larger than
+  // the requested entry contains it
+  const auto it = std::upper_bound(entries.begin(), entries.end(), entNum);
+  const auto iFile = static_cast<size_t>(std::distance(entries.begin(), it));
+  const auto firstEntry = iFile == 0 ? 0u : entries[iFile - 1];
+  return std::pair{iFile, entNum - firstEntry};
+}
+
+unsigned RNTupleReader::getEntries(const std::string& name) {
+  while (openNextReader(name)) {
+  }
+  const auto& entries = m_readerEntries[name];
+  return entries.empty() ? 0 : entries.back();
 }
 
 std::vector<std::string_view> RNTupleReader::getAvailableCategories() const {
@@ -119,13 +377,52 @@ std::unique_ptr<ROOTFrameData> RNTupleReader::readNextEntry(const std::string& n
   return readEntry(name, m_entries[name]);
 }
 
+std::unique_ptr<ROOTFrameData> RNTupleReader::readNextEntry(const std::string& name,
+                                                            const std::vector<std::string>& collsToRead) {
+  return readEntry(name, m_entries[name], collsToRead);
+}
+
 std::unique_ptr<ROOTFrameData> RNTupleReader::readEntry(const std::string& category, const unsigned entNum) {
-  if (m_totalEntries.find(category) == m_totalEntries.end()) {
-    getEntries(category);
+  if (m_collectionInfo.find(category) == m_collectionInfo.end()) {
+    if (!initCategory(category)) {
+      return nullptr;
+    }
   }
-  if (entNum >= m_totalEntries[category]) {
+
+  const auto fileAndEntry = getFileAndEntry(category, entNum);
+  if (!fileAndEntry) {
     return nullptr;
   }
+  const auto [iFile, localEntry] = *fileAndEntry;
+
+  m_entries[category] = entNum + 1;
+
+  auto& reusableEntry = getReusableEntry(category, iFile);
+  auto& dentry = *reusableEntry.entry;
+  const auto& collInfo = m_collectionInfo[category];
+
+  ROOTFrameData::BufferMap buffers;
+  for (size_t i = 0; i < collInfo.id.size(); ++i) {
+    auto collBuffers = bindCollectionBuffers(dentry, category, i);
+    if (!collBuffers) {
+      return nullptr;
+    }
+    buffers.emplace(collInfo.name[i], std::move(*collBuffers));
+  }
+
+  m_readers[category][iFile]->LoadEntry(localEntry, dentry);
+
+  auto parameters = readEventMetaData(reusableEntry.params);
+
+  return std::make_unique<ROOTFrameData>(std::move(buffers), m_idTables[category], std::move(parameters),
+                                         m_collectionLayouts[category]);
+}
+
+std::unique_ptr<ROOTFrameData> RNTupleReader::readEntry(const std::string& category, const unsigned entNum,
+                                                        const std::vector<std::string>& collsToRead) {
+  if (collsToRead.empty()) {
+    return readEntry(category, entNum);
+  }
 
   if (m_collectionInfo.find(category) == m_collectionInfo.end()) {
     if (!initCategory(category)) {
@@ -133,81 +430,108 @@ std::unique_ptr<ROOTFrameData> RNTupleReader::readEntry(const std::string& categ
     }
   }
 
+  const auto& collInfo = m_collectionInfo[category];
+  std::vector<size_t> toRead{};
+  toRead.reserve(collsToRead.size());
+  for (const auto& name : collsToRead) {
+    const auto it = std::find(collInfo.name.begin(), collInfo.name.end(), name);
+    if (it == collInfo.name.end()) {
+      throw std::invalid_argument(name + " is not available from this Frame category");
+    }
+    toRead.push_back(std::distance(collInfo.name.begin(), it));
+  }
+
+  const auto fileAndEntry = getFileAndEntry(category, entNum);
+  if (!fileAndEntry) {
+    return nullptr;
+  }
+  const auto [iFile, localEntry] = *fileAndEntry;
+
   m_entries[category] = entNum + 1;
 
   ROOTFrameData::BufferMap buffers;
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-  // We need to create a non-bare entry here, because the entries for the
-  // parameters are not explicitly (re)set and we need them default initialized.
-  // In principle we would only need a bare entry for the collection data, since
-  // we set all the fields there in any case.
-  auto dentry = m_readers[category][0]->GetModel().CreateEntry();
-#else
-  auto dentry = m_readers[category][0]->GetModel()->GetDefaultEntry();
+#if ROOT_VERSION_CODE < ROOT_VERSION(6, 32, 0)
+  std::vector<std::optional<podio::CollectionReadBuffers>> allBuffers{};
 #endif
-
-  for (size_t i = 0; i < m_collectionInfo[category].id.size(); ++i) {
-    const auto& collType = m_collectionInfo[category].type[i];
-    const auto& bufferFactory = podio::CollectionBufferFactory::instance();
-    auto maybeBuffers = bufferFactory.createBuffers(collType, m_collectionInfo[category].schemaVersion[i],
-                                                    m_collectionInfo[category].isSubsetCollection[i]);
-    auto collBuffers = maybeBuffers.value_or(podio::CollectionReadBuffers{});
-
-    if (!maybeBuffers) {
-      std::cout << "WARNING: Buffers couldn't be created for collection " << m_collectionInfo[category].name[i]
-                << " of type " << m_collectionInfo[category].type[i] << " and schema version "
-                << m_collectionInfo[category].schemaVersion[i] << std::endl;
-      return nullptr;
+  // Nothing takes ownership of the buffers that have been created so far in
+  // case reading fails, so they have to be deleted here
+  auto deleteCreatedBuffers = [&]() {
+    for (auto& [_, collBuffers] : buffers) {
+      collBuffers.deleteBuffers(collBuffers);
+    }
+#if ROOT_VERSION_CODE < ROOT_VERSION(6, 32, 0)
+    for (auto& unread : allBuffers) {
+      if (unread) {
+        unread->deleteBuffers(*unread);
+      }
     }
-
-    if (m_collectionInfo[category].isSubsetCollection[i]) {
-      auto brName = root_utils::subsetBranch(m_collectionInfo[category].name[i]);
-      auto vec = new std::vector<podio::ObjectID>;
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-      dentry->BindRawPtr(brName, vec);
-#else
-      dentry->CaptureValueUnsafe(brName, vec);
 #endif
-      collBuffers.references->at(0) = std::unique_ptr<std::vector<podio::ObjectID>>(vec);
-    } else {
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-      dentry->BindRawPtr(m_collectionInfo[category].name[i], collBuffers.data);
+  };
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  // Only the fields of the requested collections (and everything they point
+  // to) are read, via views into the reader of this file
+  auto readCollection = [this, &category, iFile = iFile, localEntry = localEntry](size_t iColl) {
+    return readCollectionViews(category, iFile, localEntry, iColl);
+  };
 #else
-      dentry->CaptureValueUnsafe(m_collectionInfo[category].name[i], collBuffers.data);
+  // Without type-erased views all fields have to be read with the reader of
+  // this file, the buffers of the collections that are not requested are
+  // discarded again
+  auto& reusableEntry = getReusableEntry(category, iFile);
+  allBuffers.reserve(collInfo.id.size());
+  for (size_t i = 0; i < collInfo.id.size(); ++i) {
+    allBuffers.emplace_back(bindCollectionBuffers(*reusableEntry.entry, category, i));
+    if (!allBuffers.back()) {
+      deleteCreatedBuffers();
+      return nullptr;
+    }
+  }
+  m_readers[category][iFile]->LoadEntry(localEntry, *reusableEntry.entry);
+  auto readCollection = [&allBuffers](size_t iColl) { return std::exchange(allBuffers[iColl], std::nullopt); };
 #endif
 
-      const auto relVecNames = podio::DatamodelRegistry::instance().getRelationNames(collType);
-      for (size_t j = 0; j < relVecNames.relations.size(); ++j) {
-        const auto relName = relVecNames.relations[j];
-        auto vec = new std::vector<podio::ObjectID>;
-        const auto brName = root_utils::refBranch(m_collectionInfo[category].name[i], relName);
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-        dentry->BindRawPtr(brName, vec);
-#else
-        dentry->CaptureValueUnsafe(brName, vec);
-#endif
-        collBuffers.references->at(j) = std::unique_ptr<std::vector<podio::ObjectID>>(vec);
-      }
+  std::vector<bool> isRead(collInfo.id.size(), false);
+  while (!toRead.empty()) {
+    const auto i = toRead.back();
+    toRead.pop_back();
+    if (isRead[i]) {
+      continue;
+    }
+    isRead[i] = true;
 
-      for (size_t j = 0; j < relVecNames.vectorMembers.size(); ++j) {
-        const auto vecName = relVecNames.vectorMembers[j];
-        const auto brName = root_utils::vecBranch(m_collectionInfo[category].name[i], vecName);
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-        dentry->BindRawPtr(brName, collBuffers.vectorMembers->at(j).second);
-#else
-        dentry->CaptureValueUnsafe(brName, collBuffers.vectorMembers->at(j).second);
-#endif
-      }
+    auto collBuffers = readCollection(i);
+    if (!collBuffers) {
+      deleteCreatedBuffers();
+      return nullptr;
     }
 
-    buffers.emplace(m_collectionInfo[category].name[i], std::move(collBuffers));
+    for (const auto target : getRelationTargets(category, *collBuffers)) {
+      if (!isRead[target]) {
+        toRead.push_back(target);
+      }
+    }
+    buffers.emplace(collInfo.name[i], std::move(*collBuffers));
   }
 
-  m_readers[category][0]->LoadEntry(entNum, *dentry);
-
-  auto parameters = readEventMetaData(category, entNum);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  auto& views = getProjectedViews(category, iFile);
+  for (auto& view : views.params) {
+    view(localEntry);
+  }
+  auto parameters = readEventMetaData(views.paramFields);
+#else
+  // Only the buffers of the collections that have not been requested are left
+  for (auto& unread : allBuffers) {
+    if (unread) {
+      unread->deleteBuffers(*unread);
+    }
+  }
+  auto parameters = readEventMetaData(reusableEntry.params);
+#endif
 
-  return std::make_unique<ROOTFrameData>(std::move(buffers), m_idTables[category], std::move(parameters));
+  return std::make_unique<ROOTFrameData>(std::move(buffers), m_idTables[category], std::move(parameters),
+                                         m_collectionLayouts[category]);
 }
 
 } // namespace podio
@@ -6,7 +6,13 @@
 #include "podio/podioVersion.h"
 #include "rootUtils.h"
 
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  #include "podio/RNTupleParallelWriter.h"
+#endif
+
+#include "Compression.h"
 #include "TFile.h"
+#include "TROOT.h"
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTuple.hxx>
@@ -16,8 +22,41 @@
 
 namespace podio {
 
-RNTupleWriter::RNTupleWriter(const std::string& filename) :
-    m_file(new TFile(filename.c_str(), "RECREATE", "data file")) {
+RNTupleWriter::RNTupleWriter(const std::string& filename) : RNTupleWriter(filename, Options{}) {
+}
+
+RNTupleWriter::RNTupleWriter(const std::string& filename, const Options& options) :
+    m_file(new TFile(filename.c_str(), "RECREATE", "data file")), m_options(options) {
+  // Implicit multi-threading is global state that other components might rely
+  // on as well, so it is only ever enabled here, never disabled
+  if (m_options.parallelCompression && !ROOT::IsImplicitMTEnabled()) {
+    ROOT::EnableImplicitMT(m_options.nThreads);
+  }
+}
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+RNTupleWriter::RNTupleWriter(std::shared_ptr<detail::RNTupleParallelWriterState> parent, const Options& options) :
+    m_options(options), m_parent(std::move(parent)) {
+}
+#endif
+
+ROOT::Experimental::RNTupleWriteOptions RNTupleWriter::Options::writeOptions() const {
+  ROOT::Experimental::RNTupleWriteOptions options{};
+  if (compressionLevel >= 0) {
+    options.SetCompression(ROOT::CompressionSettings(compressionAlgorithm, compressionLevel));
+  }
+  if (approxZippedClusterSize > 0) {
+    options.SetApproxZippedClusterSize(approxZippedClusterSize);
+  }
+  if (unzippedPageSize > 0) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 33, 0)
+    options.SetMaxUnzippedPageSize(unzippedPageSize);
+#else
+    options.SetApproxUnzippedPageSize(unzippedPageSize);
+#endif
+  }
+  options.SetUseBufferedWrite(useBufferedWrite);
+  return options;
 }
 
 RNTupleWriter::~RNTupleWriter() {
@@ -42,19 +81,25 @@ root_utils::ParamStorage<T>& RNTupleWriter::getParamStorage(CategoryInfo& catInf
 }
 
 template <typename T>
-void RNTupleWriter::fillParams(const GenericParameters& params, CategoryInfo& catInfo,
-                               ROOT::Experimental::REntry* entry) {
+void RNTupleWriter::bindParamStorage(CategoryInfo& catInfo) {
   auto& paramStorage = getParamStorage<T>(catInfo);
-  paramStorage = params.getKeysAndValues<T>();
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-  entry->BindRawPtr(root_utils::getGPKeyName<T>(), &paramStorage.keys);
-  entry->BindRawPtr(root_utils::getGPValueName<T>(), &paramStorage.values);
+  catInfo.entry->BindRawPtr(root_utils::getGPKeyName<T>(), &paramStorage.keys);
+  catInfo.entry->BindRawPtr(root_utils::getGPValueName<T>(), &paramStorage.values);
 #else
-  entry->CaptureValueUnsafe(root_utils::getGPKeyName<T>(), &paramStorage.keys);
-  entry->CaptureValueUnsafe(root_utils::getGPValueName<T>(), &paramStorage.values);
+  catInfo.entry->CaptureValueUnsafe(root_utils::getGPKeyName<T>(), &paramStorage.keys);
+  catInfo.entry->CaptureValueUnsafe(root_utils::getGPValueName<T>(), &paramStorage.values);
 #endif
 }
 
+template <typename T>
+void RNTupleWriter::fillParams(const GenericParameters& params, CategoryInfo& catInfo) {
+  auto& paramStorage = getParamStorage<T>(catInfo);
+  // Fill into the existing storage to re-use its capacity from previous frames.
+  // The storage has been bound to the entry when the category was initialized
+  params.getKeysAndValues(paramStorage.keys, paramStorage.values);
+}
+
 void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& category) {
   writeFrame(frame, category, frame.getAvailableCollections());
 }
@@ -65,7 +110,11 @@ void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& cat
 
   // Use the writer as proxy to check whether this category has been initialized
   // already and do so if not
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  const bool new_category = (catInfo.writer == nullptr && catInfo.fillContext == nullptr);
+#else
   const bool new_category = (catInfo.writer == nullptr);
+#endif
   if (new_category) {
     // This is the minimal information that we need for now
     catInfo.names = root_utils::sortAlphabeticaly(collsToWrite);
@@ -88,15 +137,38 @@ void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& cat
 
   if (new_category) {
     // Now we have enough info to populate the rest
-    auto model = createModels(collections);
-    catInfo.writer = ROOT::Experimental::RNTupleWriter::Append(std::move(model), category, *m_file.get(), {});
-
     for (const auto& [name, coll] : collections) {
       catInfo.ids.emplace_back(coll->getID());
       catInfo.types.emplace_back(coll->getTypeName());
       catInfo.subsetCollections.emplace_back(coll->isSubsetCollection());
       catInfo.schemaVersions.emplace_back(coll->getSchemaVersion());
     }
+
+    auto model = createModels(collections, catInfo.fields);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+    if (m_parent) {
+      catInfo.fillContext = RNTupleParallelWriter::registerCategory(*m_parent, category, catInfo, std::move(model));
+    } else
+#endif
+    {
+      catInfo.writer = ROOT::Experimental::RNTupleWriter::Append(std::move(model), category, *m_file.get(),
+                                                                 m_options.writeOptions());
+    }
+
+    // Create the entry once and bind the parameter storage to it. The
+    // collection buffers change from Frame to Frame and are bound below
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+    catInfo.entry = catInfo.fillContext ? catInfo.fillContext->GetModel().CreateBareEntry()
+                                        : catInfo.writer->GetModel().CreateBareEntry();
+#elif ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
+    catInfo.entry = catInfo.writer->GetModel().CreateBareEntry();
+#else
+    catInfo.entry = catInfo.writer->GetModel()->CreateBareEntry();
+#endif
+    bindParamStorage<int>(catInfo);
+    bindParamStorage<float>(catInfo);
+    bindParamStorage<double>(catInfo);
+    bindParamStorage<std::string>(catInfo);
   } else {
     if (!root_utils::checkConsistentColls(catInfo.names, collsToWrite)) {
       throw std::runtime_error("Trying to write category '" + category + "' with inconsistent collection content. " +
@@ -104,82 +176,55 @@ void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& cat
     }
   }
 
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-  auto entry = m_categories[category].writer->GetModel().CreateBareEntry();
-#else
-  auto entry = m_categories[category].writer->GetModel()->CreateBareEntry();
-#endif
-
-  ROOT::Experimental::RNTupleWriteOptions options;
-  options.SetCompression(ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose);
+  auto& entry = *catInfo.entry;
+  for (size_t i = 0; i < collections.size(); ++i) {
+    const auto collBuffers = collections[i].second->getBuffers();
+    const auto& fields = catInfo.fields[i];
 
-  for (const auto& [name, coll] : collections) {
-    auto collBuffers = coll->getBuffers();
-    if (collBuffers.vecPtr) {
+    if (!fields.data.empty()) {
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-      entry->BindRawPtr(name, (void*)collBuffers.vecPtr);
+      entry.BindRawPtr(fields.data, (void*)collBuffers.vecPtr);
 #else
-      entry->CaptureValueUnsafe(name, (void*)collBuffers.vecPtr);
+      entry.CaptureValueUnsafe(fields.data, (void*)collBuffers.vecPtr);
 #endif
     }
 
-    if (coll->isSubsetCollection()) {
-      auto& refColl = (*collBuffers.references)[0];
-      const auto brName = root_utils::subsetBranch(name);
+    for (size_t j = 0; j < fields.refs.size(); ++j) {
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-      entry->BindRawPtr(brName, refColl.get());
+      entry.BindRawPtr(fields.refs[j], (*collBuffers.references)[j].get());
 #else
-      entry->CaptureValueUnsafe(brName, refColl.get());
+      entry.CaptureValueUnsafe(fields.refs[j], (*collBuffers.references)[j].get());
 #endif
+    }
 
-    } else {
-
-      const auto relVecNames = podio::DatamodelRegistry::instance().getRelationNames(coll->getValueTypeName());
-      if (auto refColls = collBuffers.references) {
-        int i = 0;
-        for (auto& c : (*refColls)) {
-          const auto brName = root_utils::refBranch(name, relVecNames.relations[i]);
+    for (size_t j = 0; j < fields.vecMems.size(); ++j) {
+      auto ptr = *(std::vector<int>**)(*collBuffers.vectorMembers)[j].second;
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-          entry->BindRawPtr(brName, c.get());
+      entry.BindRawPtr(fields.vecMems[j], ptr);
 #else
-          entry->CaptureValueUnsafe(brName, c.get());
+      entry.CaptureValueUnsafe(fields.vecMems[j], ptr);
 #endif
-          ++i;
-        }
-      }
-
-      if (auto vmInfo = collBuffers.vectorMembers) {
-        int i = 0;
-        for (auto& [type, vec] : (*vmInfo)) {
-          const auto typeName = "vector<" + type + ">";
-          const auto brName = root_utils::vecBranch(name, relVecNames.vectorMembers[i]);
-          auto ptr = *(std::vector<int>**)vec;
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
-          entry->BindRawPtr(brName, ptr);
-#else
-          entry->CaptureValueUnsafe(brName, ptr);
-#endif
-          ++i;
-        }
-      }
     }
-
-    // Not supported
-    // entry->CaptureValueUnsafe(root_utils::paramBranchName,
-    // &const_cast<podio::GenericParameters&>(frame.getParameters()));
   }
 
   const auto& params = frame.getParameters();
-  fillParams<int>(params, catInfo, entry.get());
-  fillParams<float>(params, catInfo, entry.get());
-  fillParams<double>(params, catInfo, entry.get());
-  fillParams<std::string>(params, catInfo, entry.get());
-
-  m_categories[category].writer->Fill(*entry);
+  fillParams<int>(params, catInfo);
+  fillParams<float>(params, catInfo);
+  fillParams<double>(params, catInfo);
+  fillParams<std::string>(params, catInfo);
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  if (catInfo.fillContext) {
+    RNTupleParallelWriter::fill(*m_parent, *catInfo.fillContext, entry);
+    return;
+  }
+#endif
+  catInfo.writer->Fill(entry);
 }
 
 std::unique_ptr<ROOT::Experimental::RNTupleModel>
-RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& collections) {
+RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& collections,
+                            std::vector<CollectionFields>& fields) {
   auto model = ROOT::Experimental::RNTupleModel::CreateBare();
 
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 31, 0)
@@ -188,17 +233,21 @@ RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& coll
   using ROOT::Experimental::Detail::RFieldBase;
 #endif
 
+  fields.clear();
+  fields.reserve(collections.size());
   for (auto& [name, coll] : collections) {
     // For the first entry in each category we also record the datamodel
     // definition
     m_datamodelCollector.registerDatamodelDefinition(coll, name);
 
     const auto collBuffers = coll->getBuffers();
+    auto& collFields = fields.emplace_back();
 
     if (collBuffers.vecPtr) {
       auto collClassName = "std::vector<" + std::string(coll->getDataTypeName()) + ">";
       auto field = RFieldBase::Create(name, collClassName).Unwrap();
       model->AddField(std::move(field));
+      collFields.data = name;
     }
 
     if (coll->isSubsetCollection()) {
@@ -206,6 +255,7 @@ RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& coll
       auto collClassName = "vector<podio::ObjectID>";
       auto field = RFieldBase::Create(brName, collClassName).Unwrap();
       model->AddField(std::move(field));
+      collFields.refs.push_back(brName);
     } else {
 
       const auto relVecNames = podio::DatamodelRegistry::instance().getRelationNames(coll->getValueTypeName());
@@ -216,6 +266,7 @@ RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& coll
           auto collClassName = "vector<podio::ObjectID>";
           auto field = RFieldBase::Create(brName, collClassName).Unwrap();
           model->AddField(std::move(field));
+          collFields.refs.push_back(brName);
           ++i;
         }
       }
@@ -227,6 +278,7 @@ RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& coll
           const auto brName = root_utils::vecBranch(name, relVecNames.vectorMembers[i]);
           auto field = RFieldBase::Create(brName, typeName).Unwrap();
           model->AddField(std::move(field));
+          collFields.vecMems.push_back(brName);
           ++i;
         }
       }
@@ -260,23 +312,24 @@ RNTupleWriter::CategoryInfo& RNTupleWriter::getCategoryInfo(const std::string& c
   return it->second;
 }
 
-void RNTupleWriter::finish() {
+void RNTupleWriter::writeMetadata(TFile& file, std::vector<std::tuple<std::string, std::string>> edmDefinitions,
+                                  const std::unordered_map<std::string, CategoryInfo>& categories,
+                                  const Options& options) {
   auto metadata = ROOT::Experimental::RNTupleModel::Create();
 
   auto podioVersion = podio::version::build_version;
   auto versionField = metadata->MakeField<std::vector<uint16_t>>(root_utils::versionBranchName);
   *versionField = {podioVersion.major, podioVersion.minor, podioVersion.patch};
 
-  auto edmDefinitions = m_datamodelCollector.getDatamodelDefinitionsToWrite();
   auto edmField = metadata->MakeField<std::vector<std::tuple<std::string, std::string>>>(root_utils::edmDefBranchName);
   *edmField = std::move(edmDefinitions);
 
   auto availableCategoriesField = metadata->MakeField<std::vector<std::string>>(root_utils::availableCategories);
-  for (auto& [c, _] : m_categories) {
+  for (auto& [c, _] : categories) {
     availableCategoriesField->push_back(c);
   }
 
-  for (auto& [category, collInfo] : m_categories) {
+  for (auto& [category, collInfo] : categories) {
     auto idField = metadata->MakeField<std::vector<unsigned int>>({root_utils::idTableName(category)});
     *idField = collInfo.ids;
     auto collectionNameField = metadata->MakeField<std::vector<std::string>>({root_utils::collectionName(category)});
@@ -290,16 +343,35 @@ void RNTupleWriter::finish() {
   }
 
   metadata->Freeze();
-  auto metadataWriter =
-      ROOT::Experimental::RNTupleWriter::Append(std::move(metadata), root_utils::metaTreeName, *m_file, {});
+  auto metadataWriter = ROOT::Experimental::RNTupleWriter::Append(std::move(metadata), root_utils::metaTreeName, file,
+                                                                  options.writeOptions());
 
   metadataWriter->Fill();
+}
+
+void RNTupleWriter::finish() {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 32, 0)
+  if (m_parent) {
+    // Flush everything that has been filled by this writer. The parallel
+    // writer takes care of the metadata
+    for (auto& [_, catInfo] : m_categories) {
+      catInfo.entry.reset();
+      RNTupleParallelWriter::releaseFillContext(*m_parent, catInfo.fillContext);
+    }
+    RNTupleParallelWriter::writerFinished(*m_parent, m_datamodelCollector.getDatamodelDefinitionsToWrite());
+    m_finished = true;
+    return;
+  }
+#endif
+
+  writeMetadata(*m_file, m_datamodelCollector.getDatamodelDefinitionsToWrite(), m_categories, m_options);
 
   m_file->Write();
 
   // All the tuple writers must be deleted before the file so that they flush
   // unwritten output
   for (auto& [_, catInfo] : m_categories) {
+    catInfo.entry.reset();
     catInfo.writer.reset();
   }
 
@@ -1,25 +1,43 @@
 #include "podio/ROOTFrameData.h"
+#include "podio/CollectionBase.h"
 
 namespace podio {
 
-ROOTFrameData::ROOTFrameData(BufferMap&& buffers, CollIDPtr&& idTable, podio::GenericParameters&& params) :
-    m_buffers(std::move(buffers)), m_idTable(std::move(idTable)), m_parameters(std::move(params)) {
+ROOTFrameData::ROOTFrameData(BufferMap&& buffers, CollIDPtr&& idTable, podio::GenericParameters&& params,
+                             LayoutPtr layout, PoolPtr bufferPool, std::vector<std::string> lazyCollections,
+                             LazyReadFunc lazyRead) :
+    m_buffers(std::move(buffers)),
+    m_idTable(std::move(idTable)),
+    m_layout(std::move(layout)),
+    m_bufferPool(std::move(bufferPool)),
+    m_lazyCollections(lazyCollections.begin(), lazyCollections.end()),
+    m_lazyRead(std::move(lazyRead)),
+    m_parameters(std::move(params)) {
 }
 
 // Interim workaround for https://github.com/AIDASoft/podio#500
 ROOTFrameData::~ROOTFrameData() {
-  for (auto& [_, buffer] : m_buffers) {
-    buffer.deleteBuffers(buffer);
+  for (auto& [name, buffer] : m_buffers) {
+    if (m_bufferPool) {
+      m_bufferPool->put(name, buffer);
+    } else {
+      buffer.deleteBuffers(buffer);
+    }
   }
 }
 
 std::optional<podio::CollectionReadBuffers> ROOTFrameData::getCollectionBuffers(const std::string& name) {
-  const auto bufferHandle = m_buffers.extract(name);
-  if (bufferHandle.empty()) {
-    return std::nullopt;
+  auto maybeBuffers = std::optional<podio::CollectionReadBuffers>{std::nullopt};
+  if (auto bufferHandle = m_buffers.extract(name); !bufferHandle.empty()) {
+    maybeBuffers = std::move(bufferHandle.mapped());
+  } else if (m_lazyRead && m_lazyCollections.erase(name)) {
+    maybeBuffers = m_lazyRead(name);
   }
 
-  return {bufferHandle.mapped()};
+  if (maybeBuffers && m_bufferPool) {
+    m_handedOut.insert(name);
+  }
+  return maybeBuffers;
 }
 
 podio::CollectionIDTable ROOTFrameData::getIDTable() const {
@@ -31,12 +49,25 @@ std::unique_ptr<podio::GenericParameters> ROOTFrameData::getParameters() {
   return std::make_unique<podio::GenericParameters>(std::move(m_parameters));
 }
 
+void ROOTFrameData::recycleCollection(const std::string& name, podio::CollectionBase& coll) {
+  // Only collections that have been created from buffers of this data have
+  // buffers of the expected layout
+  if (!m_bufferPool || m_handedOut.find(name) == m_handedOut.end()) {
+    return;
+  }
+  auto buffers = coll.releaseBuffers();
+  if (buffers.references) {
+    m_bufferPool->put(name, std::move(buffers));
+  }
+}
+
 std::vector<std::string> ROOTFrameData::getAvailableCollections() const {
   std::vector<std::string> collections;
-  collections.reserve(m_buffers.size());
+  collections.reserve(m_buffers.size() + m_lazyCollections.size());
   for (const auto& [name, _] : m_buffers) {
     collections.push_back(name);
   }
+  collections.insert(collections.end(), m_lazyCollections.begin(), m_lazyCollections.end());
 
   return collections;
 }
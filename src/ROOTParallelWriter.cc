@@ -0,0 +1,128 @@
+#include "podio/ROOTParallelWriter.h"
+#include "podio/podioVersion.h"
+
+#include "rootUtils.h"
+
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace podio {
+
+ROOTParallelWriter::ROOTParallelWriter(const std::string& filename) :
+    ROOTParallelWriter(filename, ROOTWriter::Options{}) {
+}
+
+ROOTParallelWriter::ROOTParallelWriter(const std::string& filename, const ROOTWriter::Options& options) :
+    m_options(options), m_state(std::make_shared<detail::ROOTParallelWriterState>()) {
+  // The writers are meant to be used on different threads
+  ROOT::EnableThreadSafety();
+  m_state->merger = std::make_unique<detail::ROOTParallelWriterState::BufferMerger>(filename.c_str(), "recreate",
+                                                                                  m_options.compressionSettings());
+
+  // Implicit multi-threading is global state that other components might rely
+  // on as well, so it is only ever enabled here, never disabled
+  if (m_options.parallelCompression && !ROOT::IsImplicitMTEnabled()) {
+    ROOT::EnableImplicitMT(m_options.nThreads);
+  }
+}
+
+ROOTParallelWriter::~ROOTParallelWriter() {
+  {
+    std::lock_guard lock{m_state->mutex};
+    if (m_state->finished) {
+      return;
+    }
+    // Writers that are still active would write into an already merged file.
+    // They keep the merger alive, so they can still be finished safely, but
+    // the metadata will be missing from the file
+    if (m_state->activeWriters > 0) {
+      std::cerr << "ERROR: The ROOTParallelWriter is destroyed while " << m_state->activeWriters
+                << " of its writers have not yet been finished. The output file will not be readable" << std::endl;
+      return;
+    }
+  }
+  finish();
+}
+
+std::unique_ptr<ROOTWriter> ROOTParallelWriter::getWriter() {
+  std::lock_guard lock{m_state->mutex};
+  if (m_state->finished) {
+    throw std::runtime_error("Cannot get a new writer from an already finished ROOTParallelWriter");
+  }
+
+  m_state->activeWriters++;
+  // The constructor is private, so make_unique is not an option
+  return std::unique_ptr<ROOTWriter>(new ROOTWriter(m_state, m_options));
+}
+
+void ROOTParallelWriter::registerCategory(detail::ROOTParallelWriterState& state, const std::string& category,
+                                          const ROOTWriter::CategoryInfo& catInfo) {
+  std::lock_guard lock{state.mutex};
+  auto [it, inserted] = state.categories.try_emplace(category);
+  auto& info = it->second;
+  if (inserted) {
+    info.idTable = podio::CollectionIDTable(catInfo.idTable.ids(), catInfo.idTable.names());
+    info.collInfo = catInfo.collInfo;
+    info.collsToWrite = catInfo.collsToWrite;
+    return;
+  }
+
+  if (!root_utils::checkConsistentColls(info.collsToWrite, catInfo.collsToWrite)) {
+    throw std::runtime_error("Trying to write category '" + category + "' with inconsistent collection content. " +
+                             root_utils::getInconsistentCollsMsg(info.collsToWrite, catInfo.collsToWrite));
+  }
+}
+
+void ROOTParallelWriter::writerFinished(detail::ROOTParallelWriterState& state,
+                                        const std::vector<std::tuple<std::string, std::string>>& edmDefinitions) {
+  std::lock_guard lock{state.mutex};
+  for (const auto& edmDef : edmDefinitions) {
+    const auto& name = std::get<0>(edmDef);
+    if (std::find_if(state.edmDefinitions.begin(), state.edmDefinitions.end(),
+                     [&name](const auto& def) { return std::get<0>(def) == name; }) == state.edmDefinitions.end()) {
+      state.edmDefinitions.push_back(edmDef);
+    }
+  }
+  state.activeWriters--;
+}
+
+void ROOTParallelWriter::finish() {
+  std::lock_guard lock{m_state->mutex};
+  if (m_state->finished) {
+    return;
+  }
+  if (m_state->activeWriters > 0) {
+    throw std::runtime_error("Cannot finish a ROOTParallelWriter while " + std::to_string(m_state->activeWriters) +
+                             " of its writers have not yet been finished");
+  }
+
+  auto file = m_state->merger->GetFile();
+  auto* metaTree = new TTree(root_utils::metaTreeName, "metadata tree for podio I/O functionality");
+  metaTree->SetDirectory(file.get());
+
+  // Store the collection id table and collection info for reading in the meta tree
+  for (/*const*/ auto& [category, info] : m_state->categories) {
+    metaTree->Branch(root_utils::idTableName(category).c_str(), &info.idTable);
+    metaTree->Branch(root_utils::collInfoName(category).c_str(), &info.collInfo);
+  }
+
+  // Store the current podio build version into the meta data tree
+  auto podioVersion = podio::version::build_version;
+  metaTree->Branch(root_utils::versionBranchName, &podioVersion);
+  metaTree->Branch(root_utils::edmDefBranchName, &m_state->edmDefinitions);
+
+  metaTree->Fill();
+  file->Write();
+  file.reset();
+  // Destroying the merger merges everything that is still queued and closes
+  // the output file
+  m_state->merger.reset();
+
+  m_state->finished = true;
+}
+
+} // namespace podio
@@ -1,18 +1,27 @@
 #include "podio/ROOTReader.h"
 #include "podio/CollectionBase.h"
 #include "podio/CollectionBufferFactory.h"
+#include "podio/CollectionBufferPool.h"
 #include "podio/CollectionBuffers.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionLayout.h"
 #include "podio/DatamodelRegistry.h"
 #include "podio/GenericParameters.h"
 #include "podio/utilities/RootHelpers.h"
 #include "rootUtils.h"
 
+#include "MurmurHash3.h"
+
 // ROOT specific includes
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TClass.h"
+#include "TEnv.h"
+#include "TFile.h"
+#include "TROOT.h"
 #include "TTreeCache.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -26,129 +35,440 @@ std::tuple<std::vector<root_utils::CollectionBranches>, std::vector<std::pair<st
 createCollectionBranchesIndexBased(TChain* chain, const podio::CollectionIDTable& idTable,
                                    const std::vector<root_utils::CollectionWriteInfoT>& collInfo);
 
+/// Get new branch pointers for the parameters of type T from the currently
+/// loaded tree of the chain
 template <typename T>
-void ROOTReader::readParams(ROOTReader::CategoryInfo& catInfo, podio::GenericParameters& params, bool reloadBranches,
-                            unsigned int localEntry) {
-  const auto collBranchIdx = catInfo.branches.size() - root_utils::nParamBranches - 1;
+void reloadParamBranches(TChain* chain, std::vector<root_utils::CollectionBranches>& branches, size_t collBranchIdx) {
   constexpr auto brOffset = root_utils::getGPBranchOffsets<T>();
+  branches[collBranchIdx + brOffset.keys].data = root_utils::getBranch(chain, root_utils::getGPKeyName<T>());
+  branches[collBranchIdx + brOffset.values].data = root_utils::getBranch(chain, root_utils::getGPValueName<T>());
+}
+
+void ROOTReader::updateParamBranches(ROOTReader::CategoryInfo& catInfo) {
+  // After switching trees in the chain, branch pointers get invalidated so
+  // they need to be reassigned. The parameter branches are always reloaded
+  // together, so the last one keeps track for all of them
+  // NOTE: root 6.22/06 requires that we get completely new branches here,
+  // with 6.20/04 we could just re-set them
+  const auto treeNumber = catInfo.chain->GetTreeNumber();
+  if (catInfo.branchTreeNumbers.back() == treeNumber) {
+    return;
+  }
+  catInfo.branchTreeNumbers.back() = treeNumber;
 
-  if (reloadBranches) {
-    auto& keyBranch = catInfo.branches[collBranchIdx + brOffset.keys].data;
-    keyBranch = root_utils::getBranch(catInfo.chain.get(), root_utils::getGPKeyName<T>());
-    auto& valueBranch = catInfo.branches[collBranchIdx + brOffset.values].data;
-    valueBranch = root_utils::getBranch(catInfo.chain.get(), root_utils::getGPValueName<T>());
+  if (m_fileVersion < podio::version::Version{0, 99, 99}) {
+    // Parameter branch is always the last one
+    catInfo.branches.back().data = root_utils::getBranch(catInfo.chain.get(), root_utils::paramBranchName);
+  } else {
+    const auto collBranchIdx = catInfo.branches.size() - root_utils::nParamBranches - 1;
+    reloadParamBranches<int>(catInfo.chain.get(), catInfo.branches, collBranchIdx);
+    reloadParamBranches<float>(catInfo.chain.get(), catInfo.branches, collBranchIdx);
+    reloadParamBranches<double>(catInfo.chain.get(), catInfo.branches, collBranchIdx);
+    reloadParamBranches<std::string>(catInfo.chain.get(), catInfo.branches, collBranchIdx);
   }
+}
+
+template <typename T>
+void ROOTReader::readParams(ROOTReader::CategoryInfo& catInfo, root_utils::ParamStorage<T>& storage,
+                            unsigned int localEntry) {
+  const auto collBranchIdx = catInfo.branches.size() - root_utils::nParamBranches - 1;
+  constexpr auto brOffset = root_utils::getGPBranchOffsets<T>();
 
   auto keyBranch = catInfo.branches[collBranchIdx + brOffset.keys].data;
   auto valueBranch = catInfo.branches[collBranchIdx + brOffset.values].data;
 
-  root_utils::ParamStorage<T> storage;
   keyBranch->SetAddress(storage.keysPtr());
   keyBranch->GetEntry(localEntry);
   valueBranch->SetAddress(storage.valuesPtr());
   valueBranch->GetEntry(localEntry);
+}
 
+template <typename T>
+void ROOTReader::readParams(ROOTReader::CategoryInfo& catInfo, podio::GenericParameters& params,
+                            unsigned int localEntry) {
+  root_utils::ParamStorage<T> storage;
+  readParams(catInfo, storage, localEntry);
   params.loadFrom(std::move(storage.keys), std::move(storage.values));
 }
 
-GenericParameters ROOTReader::readEntryParameters(ROOTReader::CategoryInfo& catInfo, bool reloadBranches,
-                                                  unsigned int localEntry) {
+GenericParameters ROOTReader::readEntryParameters(ROOTReader::CategoryInfo& catInfo, unsigned int localEntry) {
   GenericParameters params;
+  updateParamBranches(catInfo);
 
   if (m_fileVersion < podio::version::Version{0, 99, 99}) {
-    // Parameter branch is always the last one
-    auto& paramBranches = catInfo.branches.back();
-
-    // Make sure to have a valid branch pointer after switching trees in the chain
-    // as well as on the first event
-    if (reloadBranches) {
-      paramBranches.data = root_utils::getBranch(catInfo.chain.get(), root_utils::paramBranchName);
-    }
-    auto* branch = paramBranches.data;
-
+    auto* branch = catInfo.branches.back().data;
     auto* emd = &params;
     branch->SetAddress(&emd);
     branch->GetEntry(localEntry);
   } else {
-    readParams<int>(catInfo, params, reloadBranches, localEntry);
-    readParams<float>(catInfo, params, reloadBranches, localEntry);
-    readParams<double>(catInfo, params, reloadBranches, localEntry);
-    readParams<std::string>(catInfo, params, reloadBranches, localEntry);
+    readParams<int>(catInfo, params, localEntry);
+    readParams<float>(catInfo, params, localEntry);
+    readParams<double>(catInfo, params, localEntry);
+    readParams<std::string>(catInfo, params, localEntry);
   }
 
   return params;
 }
 
+std::optional<podio::GenericParameters> ROOTReader::readParameters(const std::string& name, const unsigned entry) {
+  auto& catInfo = getCategoryInfo(name);
+  if (!catInfo.chain) {
+    return std::nullopt;
+  }
+  std::lock_guard lock{*m_readMutex};
+  if (entry >= catInfo.chain->GetEntries()) {
+    return std::nullopt;
+  }
+
+  const auto localEntry = loadTree(catInfo, entry);
+  return readEntryParameters(catInfo, localEntry);
+}
+
+template <typename T>
+bool ROOTReader::readParamStorage(const std::string& name, unsigned entry, root_utils::ParamStorage<T>& storage) {
+  auto& catInfo = getCategoryInfo(name);
+  if (!catInfo.chain) {
+    return false;
+  }
+  std::lock_guard lock{*m_readMutex};
+  if (entry >= catInfo.chain->GetEntries()) {
+    return false;
+  }
+
+  const auto localEntry = loadTree(catInfo, entry);
+  if (m_fileVersion < podio::version::Version{0, 99, 99}) {
+    // All parameters are stored in one branch for older files
+    storage = root_utils::ParamStorage<T>(readEntryParameters(catInfo, localEntry).getKeysAndValues<T>());
+  } else {
+    updateParamBranches(catInfo);
+    readParams(catInfo, storage, localEntry);
+  }
+  return true;
+}
+
+template bool ROOTReader::readParamStorage(const std::string&, unsigned, root_utils::ParamStorage<int>&);
+template bool ROOTReader::readParamStorage(const std::string&, unsigned, root_utils::ParamStorage<float>&);
+template bool ROOTReader::readParamStorage(const std::string&, unsigned, root_utils::ParamStorage<double>&);
+template bool ROOTReader::readParamStorage(const std::string&, unsigned, root_utils::ParamStorage<std::string>&);
+
 std::unique_ptr<ROOTFrameData> ROOTReader::readNextEntry(const std::string& name) {
   auto& catInfo = getCategoryInfo(name);
   return readEntry(catInfo);
 }
 
+std::unique_ptr<ROOTFrameData> ROOTReader::readNextEntry(const std::string& name,
+                                                         const std::vector<std::string>& collsToRead) {
+  auto& catInfo = getCategoryInfo(name);
+  return readEntry(catInfo, collsToRead);
+}
+
 std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(const std::string& name, const unsigned entNum) {
   auto& catInfo = getCategoryInfo(name);
   catInfo.entry = entNum;
   return readEntry(catInfo);
 }
 
-std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(ROOTReader::CategoryInfo& catInfo) {
+std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(const std::string& name, const unsigned entNum,
+                                                     const std::vector<std::string>& collsToRead) {
+  auto& catInfo = getCategoryInfo(name);
+  catInfo.entry = entNum;
+  return readEntry(catInfo, collsToRead);
+}
+
+std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(ROOTReader::CategoryInfo& catInfo,
+                                                     const std::vector<std::string>& collsToRead) {
   if (!catInfo.chain) {
     return nullptr;
   }
+  std::lock_guard lock{*m_readMutex};
   if (catInfo.entry >= catInfo.chain->GetEntries()) {
     return nullptr;
   }
 
-  // After switching trees in the chain, branch pointers get invalidated so
-  // they need to be reassigned.
-  // NOTE: root 6.22/06 requires that we get completely new branches here,
-  // with 6.20/04 we could just re-set them
-  const auto preTreeNo = catInfo.chain->GetTreeNumber();
-  const auto localEntry = catInfo.chain->LoadTree(catInfo.entry);
-  const auto treeChange = catInfo.chain->GetTreeNumber() != preTreeNo;
-  // Also need to make sure to handle the first event
-  const auto reloadBranches = treeChange || localEntry == 0;
+  const auto localEntry = loadTree(catInfo, catInfo.entry);
+
+  if (m_reuseBuffers && !catInfo.bufferPool) {
+    catInfo.bufferPool = std::make_shared<podio::CollectionBufferPool>();
+  } else if (!m_reuseBuffers) {
+    catInfo.bufferPool.reset();
+  }
 
   ROOTFrameData::BufferMap buffers;
-  for (size_t i = 0; i < catInfo.storedClasses.size(); ++i) {
-    buffers.emplace(catInfo.storedClasses[i].first, getCollectionBuffers(catInfo, i, reloadBranches, localEntry));
+  if (collsToRead.empty() && !m_readLazily) {
+    for (size_t i = 0; i < catInfo.storedClasses.size(); ++i) {
+      buffers.emplace(catInfo.storedClasses[i].first, getCollectionBuffers(catInfo, i, localEntry));
+    }
+  } else {
+    std::vector<size_t> toRead{};
+    toRead.reserve(collsToRead.size());
+    for (const auto& name : collsToRead) {
+      const auto it = std::find_if(catInfo.storedClasses.begin(), catInfo.storedClasses.end(),
+                                   [&name](const auto& storedClass) { return storedClass.first == name; });
+      if (it == catInfo.storedClasses.end()) {
+        throw std::invalid_argument(name + " is not available from this Frame category");
+      }
+      toRead.push_back(std::distance(catInfo.storedClasses.begin(), it));
+    }
+
+    // Read the requested collections and everything they point to
+    std::vector<bool> isRead(catInfo.storedClasses.size(), false);
+    while (!toRead.empty()) {
+      const auto i = toRead.back();
+      toRead.pop_back();
+      if (isRead[i]) {
+        continue;
+      }
+      isRead[i] = true;
+      auto collBuffers = getCollectionBuffers(catInfo, i, localEntry);
+      for (const auto target : getRelationTargets(catInfo, collBuffers)) {
+        if (!isRead[target]) {
+          toRead.push_back(target);
+        }
+      }
+      buffers.emplace(catInfo.storedClasses[i].first, std::move(collBuffers));
+    }
   }
 
-  auto parameters = readEntryParameters(catInfo, reloadBranches, localEntry);
+  auto parameters = readEntryParameters(catInfo, localEntry);
+
+  std::vector<std::string> lazyCollections{};
+  ROOTFrameData::LazyReadFunc lazyRead{nullptr};
+  if (m_readLazily) {
+    for (const auto& [name, _] : catInfo.storedClasses) {
+      if (buffers.find(name) == buffers.end()) {
+        lazyCollections.push_back(name);
+      }
+    }
+    lazyRead = [this, readMutex = std::weak_ptr<std::mutex>(m_readMutex), &catInfo,
+                entry = catInfo.entry](const std::string& name) -> std::optional<podio::CollectionReadBuffers> {
+      // The reader is gone, so there is nothing to read from anymore
+      const auto mutex = readMutex.lock();
+      if (!mutex) {
+        return std::nullopt;
+      }
+      std::lock_guard readLock{*mutex};
+      return readCollectionLazily(catInfo, entry, name);
+    };
+  }
 
   catInfo.entry++;
-  return std::make_unique<ROOTFrameData>(std::move(buffers), catInfo.table, std::move(parameters));
+  return std::make_unique<ROOTFrameData>(std::move(buffers), catInfo.table, std::move(parameters), catInfo.layout,
+                                         catInfo.bufferPool, std::move(lazyCollections), std::move(lazyRead));
+}
+
+std::optional<podio::CollectionReadBuffers> ROOTReader::readCollectionLazily(ROOTReader::CategoryInfo& catInfo,
+                                                                             unsigned entry, const std::string& name) {
+  const auto it = std::find_if(catInfo.storedClasses.begin(), catInfo.storedClasses.end(),
+                               [&name](const auto& storedClass) { return storedClass.first == name; });
+  if (it == catInfo.storedClasses.end()) {
+    return std::nullopt;
+  }
+
+  // The reader might have moved on to another tree in the meantime
+  const auto localEntry = loadTree(catInfo, entry);
+  return getCollectionBuffers(catInfo, std::distance(catInfo.storedClasses.begin(), it), localEntry);
+}
+
+std::vector<size_t> ROOTReader::getRelationTargets(const CategoryInfo& catInfo,
+                                                   const podio::CollectionReadBuffers& buffers) {
+  std::vector<uint32_t> collectionIDs{};
+  if (buffers.references) {
+    for (const auto& refs : *buffers.references) {
+      for (const auto& id : *refs) {
+        // The ObjectIDs of one relation usually point to very few collections, so
+        // this is cheap
+        if (id.index != podio::ObjectID::invalid &&
+            std::find(collectionIDs.begin(), collectionIDs.end(), id.collectionID) == collectionIDs.end()) {
+          collectionIDs.push_back(id.collectionID);
+        }
+      }
+    }
+  }
+
+  std::vector<size_t> targets{};
+  for (const auto collID : collectionIDs) {
+    const auto name = catInfo.table->name(collID);
+    if (!name) {
+      continue;
+    }
+    const auto it = std::find_if(catInfo.storedClasses.begin(), catInfo.storedClasses.end(),
+                                 [&name](const auto& storedClass) { return storedClass.first == name.value(); });
+    if (it != catInfo.storedClasses.end()) {
+      targets.push_back(std::distance(catInfo.storedClasses.begin(), it));
+    }
+  }
+  return targets;
 }
 
 podio::CollectionReadBuffers ROOTReader::getCollectionBuffers(ROOTReader::CategoryInfo& catInfo, size_t iColl,
-                                                              bool reloadBranches, unsigned int localEntry) {
+                                                              unsigned int localEntry) {
   const auto& name = catInfo.storedClasses[iColl].first;
   const auto& [collType, isSubsetColl, schemaVersion, index] = catInfo.storedClasses[iColl].second;
   auto& branches = catInfo.branches[index];
 
-  const auto& bufferFactory = podio::CollectionBufferFactory::instance();
-  auto maybeBuffers = bufferFactory.createBuffers(collType, schemaVersion, isSubsetColl);
+  auto maybeBuffers = std::optional<podio::CollectionReadBuffers>{std::nullopt};
+  if (catInfo.bufferPool) {
+    maybeBuffers = catInfo.bufferPool->take(name, collType, schemaVersion, isSubsetColl);
+  }
+  if (!maybeBuffers) {
+    const auto& bufferFactory = podio::CollectionBufferFactory::instance();
+    maybeBuffers = bufferFactory.createBuffers(collType, schemaVersion, isSubsetColl);
+  }
 
   // TODO: Error handling of empty optional
   auto collBuffers = maybeBuffers.value_or(podio::CollectionReadBuffers{});
 
-  if (reloadBranches) {
+  // Make sure to have valid branch pointers after switching trees in the
+  // chain as well as on the first read. Since not all collections are read for
+  // every entry, this has to be tracked per collection
+  if (const auto treeNumber = catInfo.chain->GetTreeNumber(); catInfo.branchTreeNumbers[index] != treeNumber) {
     root_utils::resetBranches(catInfo.chain.get(), branches, name);
+    catInfo.branchTreeNumbers[index] = treeNumber;
   }
 
   // set the addresses and read the data
-  root_utils::setCollectionAddresses(collBuffers, branches);
-  root_utils::readBranchesData(branches, localEntry);
-
-  collBuffers.recast(collBuffers);
+  if (catInfo.bufferPool) {
+    root_utils::setCollectionAddressesInPlace(collBuffers, branches);
+    root_utils::readBranchesData(branches, localEntry);
+  } else {
+    root_utils::setCollectionAddresses(collBuffers, branches);
+    root_utils::readBranchesData(branches, localEntry);
+    collBuffers.recast(collBuffers);
+  }
 
   return collBuffers;
 }
 
+ROOTReader::CacheStatistics& ROOTReader::CacheStatistics::operator+=(const CacheStatistics& other) {
+  bytesRead += other.bytesRead;
+  readCalls += other.readCalls;
+  cachedBytesRead += other.cachedBytesRead;
+  cachedReadCalls += other.cachedReadCalls;
+  missedBytesRead += other.missedBytesRead;
+  missedReadCalls += other.missedReadCalls;
+  return *this;
+}
+
+/// Get the cache statistics for the currently loaded tree of the chain
+ROOTReader::CacheStatistics getCurrentCacheStatistics(TChain* chain) {
+  ROOTReader::CacheStatistics stats{};
+  auto* tree = chain->GetTree();
+  if (!tree) {
+    return stats;
+  }
+  auto* file = tree->GetCurrentFile();
+  if (!file) {
+    return stats;
+  }
+
+  stats.bytesRead = file->GetBytesRead();
+  stats.readCalls = file->GetReadCalls();
+  if (auto* cache = tree->GetReadCache(file)) {
+    stats.cachedBytesRead = cache->GetBytesRead();
+    stats.cachedReadCalls = cache->GetReadCalls();
+    stats.missedBytesRead = cache->GetNoCacheBytesRead();
+    stats.missedReadCalls = cache->GetNoCacheReadCalls();
+  } else {
+    // Without a cache everything is a miss
+    stats.missedBytesRead = stats.bytesRead;
+    stats.missedReadCalls = stats.readCalls;
+  }
+  return stats;
+}
+
+long long ROOTReader::loadTree(ROOTReader::CategoryInfo& catInfo, unsigned entry) {
+  // The file of the current tree (and with it its cache) is gone after
+  // switching to another tree, so get its statistics beforehand
+  const auto prevTreeNumber = catInfo.chain->GetTreeNumber();
+  const auto prevStats = getCurrentCacheStatistics(catInfo.chain.get());
+  const auto localEntry = catInfo.chain->LoadTree(entry);
+  if (catInfo.chain->GetTreeNumber() != prevTreeNumber) {
+    catInfo.cacheStats += prevStats;
+    // All branches belong to the previous tree, which has been deleted, even
+    // if the same tree number is loaded again later
+    std::fill(catInfo.branchTreeNumbers.begin(), catInfo.branchTreeNumbers.end(), -1);
+  }
+  return localEntry;
+}
+
+void ROOTReader::setCacheOptions(const CacheOptions& options) {
+  std::lock_guard lock{*m_readMutex};
+  m_cacheOptions = options;
+  if (m_cacheOptions.asyncPrefetch) {
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+  }
+  for (auto& [_, catInfo] : m_categories) {
+    if (catInfo.table) {
+      setupCache(catInfo);
+    }
+  }
+}
+
+void ROOTReader::setupCache(ROOTReader::CategoryInfo& catInfo) {
+  const auto& options = m_cacheOptions;
+  if (options.cacheSize < 0) {
+    return;
+  }
+
+  auto* chain = catInfo.chain.get();
+  chain->SetCacheSize(options.cacheSize);
+  if (options.cacheSize == 0) {
+    return;
+  }
+  chain->SetClusterPrefetch(options.clusterPrefetch);
+
+  if (options.collections.empty()) {
+    if (options.learnEntries > 0) {
+      chain->SetCacheLearnEntries(options.learnEntries);
+    } else {
+      chain->AddBranchToCache("*", true);
+      chain->StopCacheLearningPhase();
+    }
+    return;
+  }
+
+  for (const auto& name : options.collections) {
+    const auto it = std::find_if(catInfo.storedClasses.begin(), catInfo.storedClasses.end(),
+                                 [&name](const auto& storedClass) { return storedClass.first == name; });
+    if (it == catInfo.storedClasses.end()) {
+      continue;
+    }
+    const auto& branches = catInfo.branches[std::get<3>(it->second)];
+    if (branches.data) {
+      chain->AddBranchToCache(name.c_str(), true);
+    }
+    for (const auto& refName : branches.refNames) {
+      chain->AddBranchToCache(refName.c_str(), true);
+    }
+    for (const auto& vecName : branches.vecNames) {
+      chain->AddBranchToCache(vecName.c_str(), true);
+    }
+  }
+  // The parameters are always read
+  const auto nParamBranches = m_fileVersion < podio::version::Version{0, 99, 99} ? 1 : root_utils::nParamBranches;
+  for (auto i = catInfo.branches.size() - nParamBranches; i < catInfo.branches.size(); ++i) {
+    chain->AddBranchToCache(catInfo.branches[i].data->GetName(), true);
+  }
+  chain->StopCacheLearningPhase();
+}
+
+ROOTReader::CacheStatistics ROOTReader::getCacheStatistics(const std::string& name) const {
+  const auto it = m_categories.find(name);
+  if (it == m_categories.end() || !it->second.chain) {
+    return {};
+  }
+
+  std::lock_guard lock{*m_readMutex};
+  auto stats = it->second.cacheStats;
+  stats += getCurrentCacheStatistics(it->second.chain.get());
+  return stats;
+}
+
 ROOTReader::CategoryInfo& ROOTReader::getCategoryInfo(const std::string& category) {
   if (auto it = m_categories.find(category); it != m_categories.end()) {
-    // Use the id table as proxy to check whether this category has been
-    // initialized already
-    if (it->second.table == nullptr) {
+    // Use the branches as proxy to check whether this category has been
+    // initialized already. Clones already have the meta data at this point
+    if (it->second.branches.empty()) {
       initCategory(it->second, category);
     }
     return it->second;
@@ -162,40 +482,20 @@ ROOTReader::CategoryInfo& ROOTReader::getCategoryInfo(const std::string& categor
 }
 
 void ROOTReader::initCategory(CategoryInfo& catInfo, const std::string& category) {
-  catInfo.table = std::make_shared<podio::CollectionIDTable>();
-  auto* table = catInfo.table.get();
-  auto* tableBranch = root_utils::getBranch(m_metaChain.get(), root_utils::idTableName(category));
-  tableBranch->SetAddress(&table);
-  tableBranch->GetEntry(0);
-
-  auto* collInfoBranch = root_utils::getBranch(m_metaChain.get(), root_utils::collInfoName(category));
-
-  auto collInfo = new std::vector<root_utils::CollectionWriteInfoT>();
-  if (m_fileVersion < podio::version::Version{0, 16, 4}) {
-    auto oldCollInfo = new std::vector<root_utils::CollectionInfoWithoutSchemaT>();
-    collInfoBranch->SetAddress(&oldCollInfo);
-    collInfoBranch->GetEntry(0);
-    collInfo->reserve(oldCollInfo->size());
-    for (auto&& [collID, collType, isSubsetColl] : *oldCollInfo) {
-      // Manually set the schema version to 1
-      collInfo->emplace_back(collID, std::move(collType), isSubsetColl, 1u);
-    }
-    delete oldCollInfo;
-  } else {
-    collInfoBranch->SetAddress(&collInfo);
-    collInfoBranch->GetEntry(0);
+  if (!catInfo.table) {
+    readCategoryMetadata(catInfo, category);
   }
+  const auto& collInfo = *catInfo.collInfo;
 
   // For backwards compatibility make it possible to read the index based files
   // from older versions
   if (m_fileVersion < podio::version::Version{0, 16, 99}) {
     std::tie(catInfo.branches, catInfo.storedClasses) =
-        createCollectionBranchesIndexBased(catInfo.chain.get(), *catInfo.table, *collInfo);
+        createCollectionBranchesIndexBased(catInfo.chain.get(), *catInfo.table, collInfo);
   } else {
     std::tie(catInfo.branches, catInfo.storedClasses) =
-        createCollectionBranches(catInfo.chain.get(), *catInfo.table, *collInfo);
+        createCollectionBranches(catInfo.chain.get(), *catInfo.table, collInfo);
   }
-  delete collInfo;
 
   // Finally set up the branches for the parameters
   if (m_fileVersion < podio::version::Version{0, 99, 99}) {
@@ -214,6 +514,39 @@ void ROOTReader::initCategory(CategoryInfo& catInfo, const std::string& category
     catInfo.branches.emplace_back(root_utils::getBranch(catInfo.chain.get(), root_utils::stringKeyName));
     catInfo.branches.emplace_back(root_utils::getBranch(catInfo.chain.get(), root_utils::stringValueName));
   }
+
+  // No tree of the chain has been loaded yet
+  catInfo.branchTreeNumbers.assign(catInfo.branches.size(), -1);
+
+  setupCache(catInfo);
+}
+
+void ROOTReader::readCategoryMetadata(CategoryInfo& catInfo, const std::string& category) {
+  catInfo.table = std::make_shared<podio::CollectionIDTable>();
+  auto* table = catInfo.table.get();
+  auto* tableBranch = root_utils::getBranch(m_metaChain.get(), root_utils::idTableName(category));
+  tableBranch->SetAddress(&table);
+  tableBranch->GetEntry(0);
+  catInfo.layout = std::make_shared<const podio::CollectionLayout>(*catInfo.table);
+
+  auto* collInfoBranch = root_utils::getBranch(m_metaChain.get(), root_utils::collInfoName(category));
+
+  auto collInfo = new std::vector<root_utils::CollectionWriteInfoT>();
+  if (m_fileVersion < podio::version::Version{0, 16, 4}) {
+    auto oldCollInfo = new std::vector<root_utils::CollectionInfoWithoutSchemaT>();
+    collInfoBranch->SetAddress(&oldCollInfo);
+    collInfoBranch->GetEntry(0);
+    collInfo->reserve(oldCollInfo->size());
+    for (auto&& [collID, collType, isSubsetColl] : *oldCollInfo) {
+      // Manually set the schema version to 1
+      collInfo->emplace_back(collID, std::move(collType), isSubsetColl, 1u);
+    }
+    delete oldCollInfo;
+  } else {
+    collInfoBranch->SetAddress(&collInfo);
+    collInfoBranch->GetEntry(0);
+  }
+  catInfo.collInfo = std::shared_ptr<const std::vector<root_utils::CollectionWriteInfoT>>(collInfo);
 }
 
 std::vector<std::string> getAvailableCategories(TChain* metaChain) {
@@ -240,6 +573,7 @@ void ROOTReader::openFile(const std::string& filename) {
 
 void ROOTReader::openFiles(const std::vector<std::string>& filenames) {
   m_metaChain = std::make_unique<TChain>(root_utils::metaTreeName);
+  m_filenames = filenames;
   // NOTE: We simply assume that the meta data doesn't change throughout the
   // chain! This essentially boils down to the assumption that all files that
   // are read this way were written with the same settings.
@@ -251,6 +585,173 @@ void ROOTReader::openFiles(const std::vector<std::string>& filenames) {
     }
   }
 
+  readFileMetadata();
+
+  // Do some work up front for setting up categories and setup all the chains.
+  // The rest of the setup follows on demand when the category is first read
+  for (const auto& cat : m_availCategories) {
+    auto [it, _] = m_categories.try_emplace(cat, std::make_unique<TChain>(cat.c_str()));
+    for (const auto& fn : filenames) {
+      it->second.chain->Add(fn.c_str());
+    }
+  }
+}
+
+void ROOTReader::openFiles(const std::vector<std::string>& filenames, const std::string& indexFile) {
+  if (filenames.empty()) {
+    throw std::runtime_error("No files to open");
+  }
+
+  // Read the index up front, it only contains a few entries per file
+  struct IndexEntry {
+    uint64_t hash{0};
+    std::unordered_map<std::string, Long64_t> entries{};
+  };
+  std::unordered_map<std::string, IndexEntry> index{};
+  {
+    auto file = std::unique_ptr<TFile>(TFile::Open(indexFile.c_str(), "READ"));
+    auto* indexTree = file ? file->Get<TTree>(root_utils::indexTreeName) : nullptr;
+    if (!indexTree) {
+      throw std::runtime_error("Index file " + indexFile + " couldn't be found or the \"" +
+                               root_utils::indexTreeName + "\" tree couldn't be read.");
+    }
+    std::string* filename{nullptr};
+    std::string* category{nullptr};
+    Long64_t entries{0};
+    ULong64_t hash{0};
+    indexTree->SetBranchAddress("file", &filename);
+    indexTree->SetBranchAddress("category", &category);
+    indexTree->SetBranchAddress("entries", &entries);
+    indexTree->SetBranchAddress("metadataHash", &hash);
+    for (Long64_t i = 0; i < indexTree->GetEntries(); ++i) {
+      indexTree->GetEntry(i);
+      auto& entry = index[*filename];
+      entry.hash = hash;
+      entry.entries[*category] = entries;
+    }
+    indexTree->ResetBranchAddresses();
+    delete filename;
+    delete category;
+  }
+
+  for (const auto& filename : filenames) {
+    const auto it = index.find(filename);
+    if (it == index.end()) {
+      throw std::runtime_error("File " + filename + " is not present in the index " + indexFile);
+    }
+    if (it->second.hash != index.at(filenames[0]).hash) {
+      throw std::runtime_error("File " + filename + " has different meta data than " + filenames[0] +
+                               " according to the index " + indexFile);
+    }
+  }
+
+  // The meta data are the same for all files, so that it is enough to only
+  // open the first file here
+  m_metaChain = std::make_unique<TChain>(root_utils::metaTreeName);
+  m_filenames = filenames;
+  if (!m_metaChain->Add(filenames[0].c_str(), -1)) {
+    throw std::runtime_error("File " + filenames[0] + " couldn't be found or the \"" + root_utils::metaTreeName +
+                             "\" tree couldn't be read.");
+  }
+  readFileMetadata();
+
+  if (getMetadataHash() != index.at(filenames[0]).hash) {
+    throw std::runtime_error("The meta data of file " + filenames[0] + " do not match the ones in the index " +
+                             indexFile);
+  }
+
+  // Passing the number of entries to the chains means that they don't have to
+  // open the files until they are actually read from. Files without entries in
+  // a category can be skipped entirely
+  for (const auto& cat : m_availCategories) {
+    auto [it, _] = m_categories.try_emplace(cat, std::make_unique<TChain>(cat.c_str()));
+    for (const auto& fn : filenames) {
+      const auto& fileEntries = index.at(fn).entries;
+      if (const auto entIt = fileEntries.find(cat); entIt != fileEntries.end() && entIt->second > 0) {
+        it->second.chain->Add(fn.c_str(), entIt->second);
+      }
+    }
+    // Keep at least one tree in the chain to be able to set up the branches
+    if (it->second.chain->GetNtrees() == 0) {
+      it->second.chain->Add(filenames[0].c_str());
+    }
+  }
+}
+
+void ROOTReader::createIndex(const std::vector<std::string>& filenames, const std::string& indexFile) {
+  // Gather everything first to not leave a partial index behind in case of
+  // inconsistent inputs
+  std::vector<std::tuple<std::string, std::string, Long64_t>> indexEntries{};
+  std::optional<uint64_t> metadataHash{};
+  for (const auto& filename : filenames) {
+    ROOTReader reader{};
+    reader.openFile(filename);
+    const auto hash = reader.getMetadataHash();
+    if (metadataHash && *metadataHash != hash) {
+      throw std::runtime_error("File " + filename + " has different meta data than " + filenames[0]);
+    }
+    metadataHash = hash;
+    for (const auto& cat : reader.m_availCategories) {
+      indexEntries.emplace_back(filename, cat, reader.m_categories.at(cat).chain->GetEntries());
+    }
+  }
+
+  TFile file(indexFile.c_str(), "RECREATE");
+  auto* indexTree = new TTree(root_utils::indexTreeName, "podio index for fast opening");
+  std::string filename{};
+  std::string category{};
+  Long64_t entries{0};
+  ULong64_t hash = metadataHash.value_or(0);
+  indexTree->Branch("file", &filename);
+  indexTree->Branch("category", &category);
+  indexTree->Branch("entries", &entries);
+  indexTree->Branch("metadataHash", &hash);
+  for (auto& [fn, cat, nEntries] : indexEntries) {
+    filename = std::move(fn);
+    category = std::move(cat);
+    entries = nEntries;
+    indexTree->Fill();
+  }
+  file.Write();
+  file.Close();
+}
+
+uint64_t ROOTReader::getMetadataHash() {
+  // Build a canonical string representation of everything that needs to be
+  // consistent for reading and hash that
+  std::string metadata = std::to_string(m_fileVersion.major) + "." + std::to_string(m_fileVersion.minor) + "." +
+      std::to_string(m_fileVersion.patch) + ";";
+
+  auto categories = m_availCategories;
+  std::sort(categories.begin(), categories.end());
+  for (const auto& cat : categories) {
+    auto& catInfo = m_categories.at(cat);
+    if (!catInfo.table) {
+      readCategoryMetadata(catInfo, cat);
+    }
+    metadata += cat + ":";
+    for (size_t i = 0; i < catInfo.table->ids().size(); ++i) {
+      metadata += std::to_string(catInfo.table->ids()[i]) + "=" + catInfo.table->names()[i] + ",";
+    }
+    for (const auto& [collID, collType, isSubsetColl, schemaVersion] : *catInfo.collInfo) {
+      metadata += std::to_string(collID) + "=" + collType + "/" + std::to_string(isSubsetColl) + "/" +
+          std::to_string(schemaVersion) + ",";
+    }
+    metadata += ";";
+  }
+
+  for (const auto& name : m_datamodelHolder->getAvailableDatamodels()) {
+    metadata += name + ":";
+    metadata += m_datamodelHolder->getDatamodelDefinition(name);
+    metadata += ";";
+  }
+
+  uint64_t hash[2];
+  MurmurHash3_x64_128(metadata.data(), static_cast<int>(metadata.size()), 0, hash);
+  return hash[0];
+}
+
+void ROOTReader::readFileMetadata() {
   podio::version::Version* versionPtr{nullptr};
   if (auto* versionBranch = root_utils::getBranch(m_metaChain.get(), root_utils::versionBranchName)) {
     versionBranch->SetAddress(&versionPtr);
@@ -263,20 +764,93 @@ void ROOTReader::openFiles(const std::vector<std::string>& filenames) {
     auto* datamodelDefs = new DatamodelDefinitionHolder::MapType{};
     edmDefBranch->SetAddress(&datamodelDefs);
     edmDefBranch->GetEntry(0);
-    m_datamodelHolder = DatamodelDefinitionHolder(std::move(*datamodelDefs));
+    m_datamodelHolder = std::make_shared<const DatamodelDefinitionHolder>(std::move(*datamodelDefs));
     delete datamodelDefs;
   }
 
-  // Do some work up front for setting up categories and setup all the chains
-  // and record the available categories. The rest of the setup follows on
-  // demand when the category is first read
   m_availCategories = ::podio::getAvailableCategories(m_metaChain.get());
-  for (const auto& cat : m_availCategories) {
-    auto [it, _] = m_categories.try_emplace(cat, std::make_unique<TChain>(cat.c_str()));
-    for (const auto& fn : filenames) {
-      it->second.chain->Add(fn.c_str());
+}
+
+std::unique_ptr<ROOTReader> ROOTReader::clone() {
+  // Clones are meant to be used on other threads
+  ROOT::EnableThreadSafety();
+
+  auto reader = std::make_unique<ROOTReader>();
+  reader->m_filenames = m_filenames;
+  reader->m_availCategories = m_availCategories;
+  reader->m_fileVersion = m_fileVersion;
+  reader->m_datamodelHolder = m_datamodelHolder;
+  reader->m_reuseBuffers = m_reuseBuffers;
+  reader->m_readLazily = m_readLazily;
+  reader->m_cacheOptions = m_cacheOptions;
+
+  for (const auto& category : m_availCategories) {
+    // Make sure that the meta data have been read, such that the clone doesn't
+    // have to do it again
+    const auto& catInfo = getCategoryInfo(category);
+    auto [it, _] = reader->m_categories.try_emplace(category, std::make_unique<TChain>(category.c_str()));
+    if (catInfo.chain) {
+      // Add the same files with the number of entries that are already known,
+      // such that the clone doesn't have to open all of them to get these
+      const auto* files = catInfo.chain->GetListOfFiles();
+      for (int i = 0; i < files->GetEntries(); ++i) {
+        const auto* element = static_cast<const TChainElement*>(files->At(i));
+        it->second.chain->Add(element->GetTitle(), element->GetEntries());
+      }
     }
+    it->second.table = catInfo.table;
+    it->second.layout = catInfo.layout;
+    it->second.collInfo = catInfo.collInfo;
   }
+
+  return reader;
+}
+
+std::vector<std::pair<unsigned, unsigned>> ROOTReader::getEntryRanges(const std::string& name, unsigned nRanges) {
+  auto& catInfo = getCategoryInfo(name);
+  if (!catInfo.chain || nRanges == 0) {
+    return {};
+  }
+
+  std::lock_guard lock{*m_readMutex};
+  auto* chain = catInfo.chain.get();
+  const auto nEntries = static_cast<unsigned>(chain->GetEntries());
+
+  // Collect the cluster boundaries of all the trees in the chain
+  std::vector<unsigned> clusterEnds{};
+  for (int iTree = 0; iTree < chain->GetNtrees(); ++iTree) {
+    const auto offset = chain->GetTreeOffset()[iTree];
+    // Loading the first entry of an empty tree would load the next tree
+    if (chain->GetTreeOffset()[iTree + 1] == offset) {
+      continue;
+    }
+    loadTree(catInfo, offset);
+    auto* tree = chain->GetTree();
+    if (!tree || chain->GetTreeNumber() != iTree) {
+      continue;
+    }
+    auto clusterIt = tree->GetClusterIterator(0);
+    while (clusterIt() < tree->GetEntries()) {
+      clusterEnds.push_back(offset + clusterIt.GetNextEntry());
+    }
+  }
+
+  // Close a range once it has reached its share of the entries
+  std::vector<std::pair<unsigned, unsigned>> ranges{};
+  ranges.reserve(nRanges);
+  unsigned first = 0;
+  for (const auto clusterEnd : clusterEnds) {
+    const auto target = static_cast<unsigned>(static_cast<uint64_t>(ranges.size() + 1) * nEntries / nRanges);
+    if (clusterEnd >= target && ranges.size() + 1 < nRanges && clusterEnd < nEntries) {
+      ranges.emplace_back(first, clusterEnd);
+      first = clusterEnd;
+    }
+  }
+  if (first < nEntries) {
+    ranges.emplace_back(first, nEntries);
+  }
+
+  return ranges;
 }
 
 unsigned ROOTReader::getEntries(const std::string& name) const {
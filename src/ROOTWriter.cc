@@ -3,10 +3,12 @@
 #include "podio/DatamodelRegistry.h"
 #include "podio/Frame.h"
 #include "podio/GenericParameters.h"
+#include "podio/ROOTParallelWriter.h"
 #include "podio/podioVersion.h"
 
 #include "rootUtils.h"
 
+#include "TROOT.h"
 #include "TTree.h"
 #include <tuple>
 
@@ -16,6 +18,27 @@ ROOTWriter::ROOTWriter(const std::string& filename) {
   m_file = std::make_unique<TFile>(filename.c_str(), "recreate");
 }
 
+ROOTWriter::ROOTWriter(const std::string& filename, const Options& options) : m_options(options) {
+  m_file = std::make_unique<TFile>(filename.c_str(), "recreate", "", m_options.compressionSettings());
+
+  // Implicit multi-threading is global state that other components might rely
+  // on as well, so it is only ever enabled here, never disabled
+  if (m_options.parallelCompression && !ROOT::IsImplicitMTEnabled()) {
+    ROOT::EnableImplicitMT(m_options.nThreads);
+  }
+}
+
+ROOTWriter::ROOTWriter(std::shared_ptr<detail::ROOTParallelWriterState> parent, const Options& options) :
+    m_file(parent->merger->GetFile()), m_options(options), m_parent(std::move(parent)) {
+}
+
+int ROOTWriter::Options::compressionSettings() const {
+  if (compressionLevel < 0) {
+    return ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault;
+  }
+  return ROOT::CompressionSettings(compressionAlgorithm, compressionLevel);
+}
+
 ROOTWriter::~ROOTWriter() {
   if (!m_finished) {
     finish();
@@ -34,8 +57,13 @@ void ROOTWriter::writeFrame(const podio::Frame& frame, const std::string& catego
   if (catInfo.tree == nullptr) {
     catInfo.idTable = frame.getCollectionIDTableForWrite();
     catInfo.collsToWrite = root_utils::sortAlphabeticaly(collsToWrite);
+    catInfo.options = &getCategoryOptions(category);
     catInfo.tree = new TTree(category.c_str(), (category + " data tree").c_str());
     catInfo.tree->SetDirectory(m_file.get());
+    catInfo.tree->SetAutoFlush(catInfo.options->autoFlush);
+    if (m_options.parallelCompression) {
+      catInfo.tree->SetImplicitMT(true);
+    }
   }
 
   std::vector<root_utils::StoreCollection> collections;
@@ -54,6 +82,9 @@ void ROOTWriter::writeFrame(const podio::Frame& frame, const std::string& catego
   // collections
   if (catInfo.branches.empty()) {
     initBranches(catInfo, collections, const_cast<podio::GenericParameters&>(frame.getParameters()));
+    if (m_parent) {
+      ROOTParallelWriter::registerCategory(*m_parent, category, catInfo);
+    }
 
   } else {
     // Make sure that the category contents are consistent with the initial
@@ -67,6 +98,16 @@ void ROOTWriter::writeFrame(const podio::Frame& frame, const std::string& catego
   }
 
   catInfo.tree->Fill();
+
+  // Writers of a ROOTParallelWriter fill an in-memory file. Hand its contents
+  // over to the merger whenever the baskets have been flushed, so that the
+  // complete output does not pile up in memory until finish()
+  if (m_parent) {
+    const auto autoFlush = catInfo.tree->GetAutoFlush();
+    if (autoFlush > 0 && catInfo.tree->GetEntries() % autoFlush == 0) {
+      m_file->Write();
+    }
+  }
 }
 
 ROOTWriter::CategoryInfo& ROOTWriter::getCategoryInfo(const std::string& category) {
@@ -78,12 +119,26 @@ ROOTWriter::CategoryInfo& ROOTWriter::getCategoryInfo(const std::string& categor
   return it->second;
 }
 
+const ROOTWriter::CategoryOptions& ROOTWriter::getCategoryOptions(const std::string& category) const {
+  if (const auto it = m_options.categories.find(category); it != m_options.categories.end()) {
+    return it->second;
+  }
+  return m_options.defaultCategory;
+}
+
 void ROOTWriter::initBranches(CategoryInfo& catInfo, const std::vector<root_utils::StoreCollection>& collections,
                               /*const*/ podio::GenericParameters& parameters) {
   catInfo.branches.reserve(collections.size() + root_utils::nParamBranches); // collections + parameters
+  const auto& options = *catInfo.options;
+  const auto basketSize = options.basketSize;
 
   // First collections
   for (auto& [name, coll] : collections) {
+    auto splitLevel = options.splitLevel;
+    if (const auto it = options.collectionSplitLevels.find(name); it != options.collectionSplitLevels.end()) {
+      splitLevel = it->second;
+    }
+
     // For the first entry in each category we also record the datamodel
     // definition
     m_datamodelCollector.registerDatamodelDefinition(coll, name);
@@ -94,18 +149,19 @@ void ROOTWriter::initBranches(CategoryInfo& catInfo, const std::vector<root_util
     if (coll->isSubsetCollection()) {
       auto& refColl = (*buffers.references)[0];
       const auto brName = root_utils::subsetBranch(name);
-      branches.refs.push_back(catInfo.tree->Branch(brName.c_str(), refColl.get()));
+      branches.refs.push_back(catInfo.tree->Branch(brName.c_str(), refColl.get(), basketSize, splitLevel));
     } else {
       // For "proper" collections we populate all branches, starting with the data
       const auto bufferDataType = "vector<" + std::string(coll->getDataTypeName()) + ">";
-      branches.data = catInfo.tree->Branch(name.c_str(), bufferDataType.c_str(), buffers.data);
+      branches.data =
+          catInfo.tree->Branch(name.c_str(), bufferDataType.c_str(), buffers.data, basketSize, splitLevel);
 
       const auto relVecNames = podio::DatamodelRegistry::instance().getRelationNames(coll->getValueTypeName());
       if (auto refColls = buffers.references) {
         int i = 0;
         for (auto& c : (*refColls)) {
           const auto brName = root_utils::refBranch(name, relVecNames.relations[i++]);
-          branches.refs.push_back(catInfo.tree->Branch(brName.c_str(), c.get()));
+          branches.refs.push_back(catInfo.tree->Branch(brName.c_str(), c.get(), basketSize, splitLevel));
         }
       }
 
@@ -114,7 +170,7 @@ void ROOTWriter::initBranches(CategoryInfo& catInfo, const std::vector<root_util
         for (auto& [type, vec] : (*vmInfo)) {
           const auto typeName = "vector<" + type + ">";
           const auto brName = root_utils::vecBranch(name, relVecNames.vectorMembers[i++]);
-          branches.vecs.push_back(catInfo.tree->Branch(brName.c_str(), typeName.c_str(), vec));
+          branches.vecs.push_back(catInfo.tree->Branch(brName.c_str(), typeName.c_str(), vec, basketSize, splitLevel));
         }
       }
     }
@@ -127,17 +183,22 @@ void ROOTWriter::initBranches(CategoryInfo& catInfo, const std::vector<root_util
   fillParams(catInfo, parameters);
   // NOTE: The order in which these are created is codified for later use in
   // root_utils::getGPBranchOffsets
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intKeyName, &catInfo.intParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intValueName, &catInfo.intParams.values));
-
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatKeyName, &catInfo.floatParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatValueName, &catInfo.floatParams.values));
-
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::doubleKeyName, &catInfo.doubleParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::doubleValueName, &catInfo.doubleParams.values));
-
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::stringKeyName, &catInfo.stringParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::stringValueName, &catInfo.stringParams.values));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intKeyName, &catInfo.intParams.keys, basketSize));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intValueName, &catInfo.intParams.values, basketSize));
+
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatKeyName, &catInfo.floatParams.keys, basketSize));
+  catInfo.branches.emplace_back(
+      catInfo.tree->Branch(root_utils::floatValueName, &catInfo.floatParams.values, basketSize));
+
+  catInfo.branches.emplace_back(
+      catInfo.tree->Branch(root_utils::doubleKeyName, &catInfo.doubleParams.keys, basketSize));
+  catInfo.branches.emplace_back(
+      catInfo.tree->Branch(root_utils::doubleValueName, &catInfo.doubleParams.values, basketSize));
+
+  catInfo.branches.emplace_back(
+      catInfo.tree->Branch(root_utils::stringKeyName, &catInfo.stringParams.keys, basketSize));
+  catInfo.branches.emplace_back(
+      catInfo.tree->Branch(root_utils::stringValueName, &catInfo.stringParams.values, basketSize));
 }
 
 void ROOTWriter::resetBranches(CategoryInfo& categoryInfo,
@@ -170,6 +231,16 @@ void ROOTWriter::resetBranches(CategoryInfo& categoryInfo,
 }
 
 void ROOTWriter::finish() {
+  if (m_parent) {
+    // Send everything to the parallel writer, which writes the metadata once
+    // all writers are done
+    m_file->Write();
+    m_file.reset();
+    ROOTParallelWriter::writerFinished(*m_parent, m_datamodelCollector.getDatamodelDefinitionsToWrite());
+    m_finished = true;
+    return;
+  }
+
   auto* metaTree = new TTree(root_utils::metaTreeName, "metadata tree for podio I/O functionality");
   metaTree->SetDirectory(m_file.get());
 
@@ -204,10 +275,11 @@ ROOTWriter::checkConsistency(const std::vector<std::string>& collsToWrite, const
 }
 
 void ROOTWriter::fillParams(CategoryInfo& catInfo, const GenericParameters& params) {
-  catInfo.intParams = params.getKeysAndValues<int>();
-  catInfo.floatParams = params.getKeysAndValues<float>();
-  catInfo.doubleParams = params.getKeysAndValues<double>();
-  catInfo.stringParams = params.getKeysAndValues<std::string>();
+  // Fill into the existing storage to re-use its capacity from previous frames
+  params.getKeysAndValues(catInfo.intParams.keys, catInfo.intParams.values);
+  params.getKeysAndValues(catInfo.floatParams.keys, catInfo.floatParams.values);
+  params.getKeysAndValues(catInfo.doubleParams.keys, catInfo.doubleParams.values);
+  params.getKeysAndValues(catInfo.stringParams.keys, catInfo.stringParams.values);
 }
 
 } // namespace podio
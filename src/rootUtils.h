@@ -25,6 +25,12 @@ namespace podio::root_utils {
  */
 constexpr static auto metaTreeName = "podio_metadata";
 
+/**
+ * The name of the tree in the index files that can be used to open many podio
+ * ROOT files without having to open all of them up front
+ */
+constexpr static auto indexTreeName = "podio_index";
+
 /**
  * The name of the branch in the TTree for each frame for storing the
  * GenericParameters
@@ -229,6 +235,34 @@ inline void setCollectionAddresses(const BufferT& collBuffers, const CollectionB
   }
 }
 
+/**
+ * Set the addresses of existing buffers, such that reading fills them directly,
+ * re-using their capacity. In contrast to setCollectionAddresses, ROOT does not
+ * create new buffers for the data and vector members, so there is no need to
+ * recast the buffers afterwards.
+ */
+inline void setCollectionAddressesInPlace(const podio::CollectionReadBuffers& collBuffers,
+                                          CollectionBranches& branches) {
+  if (auto buffer = collBuffers.data) {
+    branches.dataPtr = buffer;
+    branches.data->SetAddress(&branches.dataPtr);
+  }
+
+  if (auto refCollections = collBuffers.references) {
+    for (size_t i = 0; i < refCollections->size(); ++i) {
+      branches.refs[i]->SetAddress(&(*refCollections)[i]);
+    }
+  }
+
+  if (auto vecMembers = collBuffers.vectorMembers) {
+    branches.vecPtrs.resize(vecMembers->size());
+    for (size_t i = 0; i < vecMembers->size(); ++i) {
+      branches.vecPtrs[i] = (*vecMembers)[i].second;
+      branches.vecs[i]->SetAddress(&branches.vecPtrs[i]);
+    }
+  }
+}
+
 inline void readBranchesData(const CollectionBranches& branches, Long64_t entry) {
   // Read all data
   if (branches.data) {
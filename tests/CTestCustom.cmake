@@ -15,6 +15,12 @@ if ((NOT "@FORCE_RUN_ALL_TESTS@" STREQUAL "ON") AND (NOT "@USE_SANITIZER@" STREQ
     check_benchmark_outputs
     read_frame_legacy_root
     read_frame_root_multiple
+    read_frame_root_select
+    read_frame_root_lazy
+    read_frame_root_cache
+    read_frame_root_clones
+    read_frame_root_index
+    read_frame_root_params
     write_python_frame_root
     read_python_frame_root
     read_and_write_frame_root
@@ -23,6 +29,10 @@ if ((NOT "@FORCE_RUN_ALL_TESTS@" STREQUAL "ON") AND (NOT "@USE_SANITIZER@" STREQ
 
     write_frame_root
     read_frame_root
+    write_frame_root_options
+    read_frame_root_options
+    write_frame_root_parallel
+    read_frame_root_parallel
 
     write_interface_root
     read_interface_root
@@ -0,0 +1,44 @@
+#include "read_frame.h"
+
+#include "podio/ROOTReader.h"
+
+#include <iostream>
+#include <stdexcept>
+
+int main() {
+  auto reader = podio::ROOTReader();
+  try {
+    reader.openFiles({"example_frame.root", "example_frame.root"});
+  } catch (const std::runtime_error& e) {
+    std::cout << "File could not be opened, aborting." << std::endl;
+    return 1;
+  }
+
+  auto options = podio::ROOTReader::CacheOptions{};
+  options.cacheSize = 10 * 1024 * 1024;
+  options.collections = {"hits", "clusters"};
+  reader.setCacheOptions(options);
+
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    auto frame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(frame, (i % 10), reader.currentFileVersion());
+  }
+
+  const auto stats = reader.getCacheStatistics("events");
+  if (stats.bytesRead == 0 || stats.readCalls == 0) {
+    std::cerr << "The cache statistics should account for the bytes that have been read" << std::endl;
+    return 1;
+  }
+  if (stats.cachedBytesRead == 0 || stats.hitRate() <= 0 || stats.hitRate() > 1) {
+    std::cerr << "The cache should have served some of the reads (hit rate: " << stats.hitRate() << ")" << std::endl;
+    return 1;
+  }
+
+  const auto noStats = reader.getCacheStatistics("not_present");
+  if (noStats.bytesRead != 0 || noStats.hitRate() != 0) {
+    std::cerr << "Unknown categories should have empty cache statistics" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include "read_frame.h"
+
+#include "podio/ROOTReader.h"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+int main() {
+  auto reader = podio::ROOTReader();
+  try {
+    reader.openFiles({"example_frame.root", "example_frame.root"});
+  } catch (const std::runtime_error& e) {
+    std::cout << "File could not be opened, aborting." << std::endl;
+    return 1;
+  }
+
+  constexpr unsigned nThreads = 4;
+  const auto ranges = reader.getEntryRanges("events", nThreads);
+  if (ranges.empty() || ranges.size() > nThreads || ranges.front().first != 0 ||
+      ranges.back().second != reader.getEntries("events")) {
+    std::cerr << "The entry ranges do not cover all entries" << std::endl;
+    return 1;
+  }
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    if (ranges[i].first != ranges[i - 1].second) {
+      std::cerr << "The entry ranges are not consecutive" << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<std::unique_ptr<podio::ROOTReader>> clones;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    clones.emplace_back(reader.clone());
+  }
+
+  std::atomic<unsigned> nProcessed{0};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      try {
+        auto& clone = *clones[i];
+        for (auto entry = ranges[i].first; entry < ranges[i].second; ++entry) {
+          const auto frame = podio::Frame(clone.readEntry("events", entry));
+          processEvent(frame, entry % 10, clone.currentFileVersion());
+          nProcessed++;
+        }
+      } catch (const std::exception& e) {
+        std::cerr << "Failed to process an entry range: " << e.what() << std::endl;
+        failed = true;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (failed || nProcessed != reader.getEntries("events")) {
+    std::cerr << "Could not process all entries with the clones" << std::endl;
+    return 1;
+  }
+
+  if (clones[0]->getAvailableDatamodels() != reader.getAvailableDatamodels()) {
+    std::cerr << "The clones should share the datamodel definitions" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include "read_frame.h"
+
+#include "podio/ROOTReader.h"
+
+#include <stdexcept>
+
+int main() {
+  podio::ROOTReader::createIndex({"example_frame.root"}, "example_frame_index.root");
+
+  // Files that are not part of the index cannot be opened via the index
+  try {
+    auto reader = podio::ROOTReader();
+    reader.openFiles({"example_frame.root", "not_indexed.root"}, "example_frame_index.root");
+    std::cerr << "Opening a file that is not present in the index should throw" << std::endl;
+    return 1;
+  } catch (const std::runtime_error&) {
+  }
+
+  auto reader = podio::ROOTReader();
+  reader.openFiles({"example_frame.root", "example_frame.root"}, "example_frame_index.root");
+
+  if (reader.currentFileVersion() != podio::version::build_version) {
+    std::cerr << "The podio build version could not be read back correctly. "
+              << "(expected:" << podio::version::build_version << ", actual: " << reader.currentFileVersion() << ")"
+              << std::endl;
+    return 1;
+  }
+
+  if (reader.getEntries("events") != 20 || reader.getEntries("other_events") != 20) {
+    std::cerr << "Could not read back the number of events correctly from the index. "
+              << "(expected: 20, actual: " << reader.getEntries("events") << ", "
+              << reader.getEntries("other_events") << ")" << std::endl;
+    return 1;
+  }
+
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    auto frame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(frame, (i % 10), reader.currentFileVersion());
+
+    auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
+    processEvent(otherFrame, (i % 10) + 100, reader.currentFileVersion());
+    processExtensions(otherFrame, (i % 10) + 100, reader.currentFileVersion());
+  }
+
+  if (reader.readNextEntry("events")) {
+    std::cerr << "Trying to read more frame data than is present should return a nullptr" << std::endl;
+    return 1;
+  }
+
+  // Jumping across the file boundary also works
+  auto frame = podio::Frame(reader.readEntry("events", 14));
+  processEvent(frame, 4, reader.currentFileVersion());
+
+  return 0;
+}
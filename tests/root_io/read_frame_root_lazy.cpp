@@ -0,0 +1,62 @@
+#include "read_frame.h"
+
+#include "podio/ROOTReader.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+  auto reader = podio::ROOTReader();
+  try {
+    // Use two files to make sure that the deferred reads also work after the
+    // reader has switched trees in the chain
+    reader.openFiles({"example_frame.root", "example_frame.root"});
+  } catch (const std::runtime_error& e) {
+    std::cout << "File could not be opened, aborting." << std::endl;
+    return 1;
+  }
+  reader.setReadLazily(true);
+
+  // Read all the entries first, such that the collections are only read once
+  // the reader has already moved on
+  std::vector<podio::Frame> frames;
+  frames.reserve(reader.getEntries("events"));
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    frames.emplace_back(reader.readNextEntry("events"));
+  }
+
+  const auto expectedColls = [&reader]() {
+    auto frame = podio::Frame(reader.readEntry("events", 0));
+    auto colls = frame.getAvailableCollections();
+    std::sort(colls.begin(), colls.end());
+    return colls;
+  }();
+  if (expectedColls.empty()) {
+    std::cerr << "All collections should be available from a lazily read Frame" << std::endl;
+    return 1;
+  }
+
+  // Process them in reverse order to switch trees back and forth
+  for (size_t i = frames.size(); i-- > 0;) {
+    processEvent(frames[i], (i % 10), reader.currentFileVersion());
+  }
+
+  // Explicitly requested collections are read right away, everything else is
+  // still available
+  {
+    auto frame = podio::Frame(reader.readEntry("events", 13, {"clusters"}));
+    auto available = frame.getAvailableCollections();
+    std::sort(available.begin(), available.end());
+    if (available != expectedColls) {
+      std::cerr << "Requesting collections should not change the available collections of a lazily read Frame"
+                << std::endl;
+      return 1;
+    }
+    processEvent(frame, 3, reader.currentFileVersion());
+  }
+
+  return 0;
+}
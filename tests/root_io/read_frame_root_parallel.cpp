@@ -0,0 +1,52 @@
+#include "read_frame.h"
+
+#include "podio/ROOTReader.h"
+
+#include <iostream>
+#include <set>
+#include <string>
+
+/// The frames are in the order in which the writers have been finished, so
+/// get the event number from the contents
+int getEventNumber(const podio::Frame& frame) {
+  return static_cast<int>(frame.getParameter<float>("UserEventWeight").value() / 100.f);
+}
+
+int main() {
+  auto reader = podio::ROOTReader();
+  try {
+    reader.openFile("example_frame_parallel.root");
+  } catch (const std::runtime_error& e) {
+    std::cout << "File could not be opened, aborting." << std::endl;
+    return 1;
+  }
+
+  if (reader.getEntries(podio::Category::Event) != 10 || reader.getEntries("other_events") != 10) {
+    std::cerr << "Could not read back the number of events correctly. (expected: 10, actual: "
+              << reader.getEntries(podio::Category::Event) << ", " << reader.getEntries("other_events") << ")"
+              << std::endl;
+    return 1;
+  }
+
+  std::set<int> events{};
+  std::set<int> otherEvents{};
+  for (size_t i = 0; i < reader.getEntries(podio::Category::Event); ++i) {
+    const auto frame = podio::Frame(reader.readNextEntry(podio::Category::Event));
+    const auto eventNumber = getEventNumber(frame);
+    processEvent(frame, eventNumber, reader.currentFileVersion());
+    events.insert(eventNumber);
+
+    const auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
+    const auto otherEventNumber = getEventNumber(otherFrame);
+    processEvent(otherFrame, otherEventNumber, reader.currentFileVersion());
+    processExtensions(otherFrame, otherEventNumber, reader.currentFileVersion());
+    otherEvents.insert(otherEventNumber);
+  }
+
+  if (events.size() != 10 || *events.begin() != 0 || otherEvents.size() != 10 || *otherEvents.begin() != 100) {
+    std::cerr << "Not all the frames that have been written in parallel could be read back" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
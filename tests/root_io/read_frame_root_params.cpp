@@ -0,0 +1,65 @@
+#include "read_frame.h"
+
+#include "podio/ROOTReader.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+  auto reader = podio::ROOTReader();
+  reader.openFiles({"example_frame.root", "example_frame.root"});
+
+  const auto anInts = reader.scanParameter<int>("events", "anInt");
+  if (anInts.size() != 20) {
+    std::cerr << "Scanning a parameter should give one value per entry (expected: 20, actual: " << anInts.size()
+              << ")" << std::endl;
+    return 1;
+  }
+  for (size_t i = 0; i < anInts.size(); ++i) {
+    if (anInts[i] != 42 + int(i % 10)) {
+      std::cerr << "Scanned parameter anInt not as expected for entry " << i << std::endl;
+      return 1;
+    }
+  }
+
+  const auto vecData = reader.scanParameter<std::vector<double>>("other_events", "SomeVectorData");
+  if (vecData.size() != 20) {
+    std::cerr << "Scanning a parameter should give one value per entry (expected: 20, actual: " << vecData.size()
+              << ")" << std::endl;
+    return 1;
+  }
+  for (size_t i = 0; i < vecData.size(); ++i) {
+    const auto iFrame = (i % 10) + 100;
+    if (!vecData[i] || *vecData[i] != std::vector{iFrame * 1.1, iFrame * 2.2}) {
+      std::cerr << "Scanned parameter SomeVectorData not as expected for entry " << i << std::endl;
+      return 1;
+    }
+  }
+
+  for (const auto& value : reader.scanParameter<std::string>("events", "not_present")) {
+    if (value) {
+      std::cerr << "Scanning a non-existant parameter should only give empty values" << std::endl;
+      return 1;
+    }
+  }
+
+  const auto params = reader.readParameters("events", 14);
+  if (!params || params->get<int>("anInt") != 46 || params->get<std::string>("SomeValue") != "string value") {
+    std::cerr << "Parameters of a single entry not read back as expected" << std::endl;
+    return 1;
+  }
+
+  if (reader.readParameters("events", 20) || reader.readParameters("not_present", 0)) {
+    std::cerr << "Reading parameters of non-existant entries should return an empty optional" << std::endl;
+    return 1;
+  }
+
+  // Reading parameters does not affect reading the full entries
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    auto frame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(frame, (i % 10), reader.currentFileVersion());
+  }
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include "datamodel/ExampleClusterCollection.h"
+#include "datamodel/ExampleHitCollection.h"
+
+#include "podio/Frame.h"
+#include "podio/ROOTReader.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+  auto reader = podio::ROOTReader();
+  try {
+    reader.openFile("example_frame.root");
+  } catch (const std::runtime_error& e) {
+    std::cout << "File could not be opened, aborting." << std::endl;
+    return 1;
+  }
+
+  // Only the info collection is read, since it has no relations
+  {
+    const auto frame = podio::Frame(reader.readNextEntry("events", {"info"}));
+    const auto available = frame.getAvailableCollections();
+    if (available != std::vector<std::string>{"info"}) {
+      std::cerr << "Reading only the info collection should make only that available" << std::endl;
+      return 1;
+    }
+  }
+
+  // The hits are read in addition to the clusters since the clusters point to them
+  {
+    const auto frame = podio::Frame(reader.readEntry("events", 0, {"clusters"}));
+    auto available = frame.getAvailableCollections();
+    std::sort(available.begin(), available.end());
+    if (available != std::vector<std::string>{"clusters", "hits"}) {
+      std::cerr << "Reading the clusters should also read the hits (and nothing else)" << std::endl;
+      return 1;
+    }
+
+    const auto& clusters = frame.get<ExampleClusterCollection>("clusters");
+    const auto& hits = frame.get<ExampleHitCollection>("hits");
+    if (clusters[2].Hits(0) != hits[0] || clusters[2].Clusters(1) != clusters[1]) {
+      std::cerr << "The relations of the clusters could not be resolved" << std::endl;
+      return 1;
+    }
+  }
+
+  try {
+    reader.readNextEntry("events", {"non-existant"});
+    std::cerr << "Trying to read a non-existant collection should throw" << std::endl;
+    return 1;
+  } catch (const std::invalid_argument&) {
+  }
+
+  return 0;
+}
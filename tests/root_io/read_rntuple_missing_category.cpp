@@ -0,0 +1,52 @@
+#include "read_frame.h"
+#include "write_frame.h"
+
+#include "podio/RNTupleReader.h"
+#include "podio/RNTupleWriter.h"
+
+int main() {
+  // A file that only contains the events category
+  {
+    podio::RNTupleWriter writer("example_rntuple_events_only.root");
+    for (int i = 0; i < 10; ++i) {
+      auto frame = makeFrame(i);
+      writer.writeFrame(frame, podio::Category::Event, collsToWrite);
+    }
+    writer.finish();
+  }
+
+  auto reader = podio::RNTupleReader();
+  reader.openFiles({"example_rntuple.root", "example_rntuple_events_only.root"});
+
+  if (reader.getEntries("events") != 20) {
+    std::cerr << "Could not read back the number of events correctly. "
+              << "(expected:" << 20 << ", actual: " << reader.getEntries("events") << ")" << std::endl;
+    return 1;
+  }
+
+  // The second file doesn't contain this category, so only the entries of the
+  // first one are available
+  if (reader.getEntries("other_events") != 10) {
+    std::cerr << "Could not read back the number of other_events correctly. "
+              << "(expected:" << 10 << ", actual: " << reader.getEntries("other_events") << ")" << std::endl;
+    return 1;
+  }
+
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    auto frame = podio::Frame(reader.readEntry("events", i));
+    processEvent(frame, (i % 10), reader.currentFileVersion());
+  }
+
+  for (size_t i = 0; i < reader.getEntries("other_events"); ++i) {
+    auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
+    processEvent(otherFrame, i + 100, reader.currentFileVersion());
+    processExtensions(otherFrame, i + 100, reader.currentFileVersion());
+  }
+
+  if (reader.readNextEntry("other_events")) {
+    std::cerr << "Trying to read more frame data than is present should return a nullptr" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,41 @@
+#include "read_frame.h"
+
+#include "podio/RNTupleReader.h"
+
+int main() {
+  auto reader = podio::RNTupleReader();
+  reader.openFiles({"example_rntuple.root", "example_rntuple.root"});
+
+  // Jumping into the second file before anything else has been read opens the
+  // necessary files on demand
+  {
+    auto frame = podio::Frame(reader.readEntry("events", 14));
+    processEvent(frame, 4, reader.currentFileVersion());
+  }
+
+  if (reader.getEntries("events") != 20) {
+    std::cerr << "Could not read back the number of events correctly. "
+              << "(expected:" << 20 << ", actual: " << reader.getEntries("events") << ")" << std::endl;
+    return 1;
+  }
+
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    auto frame = podio::Frame(reader.readEntry("events", i));
+    processEvent(frame, (i % 10), reader.currentFileVersion());
+
+    auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
+    processEvent(otherFrame, (i % 10) + 100, reader.currentFileVersion());
+    processExtensions(otherFrame, (i % 10) + 100, reader.currentFileVersion());
+  }
+
+  if (reader.readNextEntry("other_events")) {
+    std::cerr << "Trying to read more frame data than is present should return a nullptr" << std::endl;
+    return 1;
+  }
+
+  // Jumping back into the first file also works
+  auto frame = podio::Frame(reader.readEntry("events", 2));
+  processEvent(frame, 2, reader.currentFileVersion());
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include "write_frame.h"
+
+#include "podio/ROOTWriter.h"
+
+#include "TBranch.h"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <iostream>
+#include <memory>
+
+int main(int, char**) {
+  auto options = podio::ROOTWriter::Options{};
+  options.compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+  options.compressionLevel = 4;
+  options.defaultCategory.basketSize = 16000;
+  options.defaultCategory.autoFlush = 5;
+  options.defaultCategory.collectionSplitLevels = {{"hits", 0}};
+  auto& otherOptions = options.categories[std::string("other_events")];
+  otherOptions.splitLevel = 1;
+  options.parallelCompression = true;
+  options.nThreads = 2;
+
+  {
+    podio::ROOTWriter writer("example_frame_options.root", options);
+    write_frames(writer);
+  }
+
+  auto file = std::unique_ptr<TFile>(TFile::Open("example_frame_options.root"));
+  if (file->GetCompressionSettings() != ROOT::CompressionSettings(ROOT::RCompressionSetting::EAlgorithm::kLZ4, 4)) {
+    std::cerr << "The compression settings have not been applied to the file" << std::endl;
+    return 1;
+  }
+
+  auto* events = file->Get<TTree>(podio::Category::Event);
+  if (events->GetAutoFlush() != 5) {
+    std::cerr << "The auto-flush setting has not been applied (expected: 5, actual: " << events->GetAutoFlush() << ")"
+              << std::endl;
+    return 1;
+  }
+  if (events->GetBranch("hits")->GetSplitLevel() != 0 || events->GetBranch("clusters")->GetSplitLevel() != 99) {
+    std::cerr << "The split level of the hits should have been overriden" << std::endl;
+    return 1;
+  }
+  if (events->GetBranch("clusters")->GetBasketSize() != 16000) {
+    std::cerr << "The basket size has not been applied (expected: 16000, actual: "
+              << events->GetBranch("clusters")->GetBasketSize() << ")" << std::endl;
+    return 1;
+  }
+
+  auto* otherEvents = file->Get<TTree>("other_events");
+  if (otherEvents->GetBranch("clusters")->GetSplitLevel() != 1 || otherEvents->GetAutoFlush() == 5) {
+    std::cerr << "The category specific settings should have been used for other_events" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
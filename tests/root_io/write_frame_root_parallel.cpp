@@ -0,0 +1,38 @@
+#include "write_frame.h"
+
+#include "podio/ROOTParallelWriter.h"
+
+#include <thread>
+#include <vector>
+
+int main(int, char**) {
+  constexpr int nThreads = 2;
+  // Flush often, so that the writers hand over their data to the merger
+  // several times before they are finished
+  auto options = podio::ROOTWriter::Options{};
+  options.defaultCategory.autoFlush = 2;
+  podio::ROOTParallelWriter parallelWriter("example_frame_parallel.root", options);
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads);
+  for (int iThread = 0; iThread < nThreads; ++iThread) {
+    threads.emplace_back([&parallelWriter, iThread]() {
+      auto writer = parallelWriter.getWriter();
+      for (int i = iThread; i < 10; i += nThreads) {
+        auto frame = makeFrame(i);
+        writer->writeFrame(frame, podio::Category::Event, collsToWrite);
+      }
+      for (int i = 100 + iThread; i < 110; i += nThreads) {
+        auto frame = makeFrame(i);
+        writer->writeFrame(frame, "other_events");
+      }
+      writer->finish();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  parallelWriter.finish();
+  return 0;
+}
@@ -0,0 +1,22 @@
+#include "read_frame.h"
+#include "write_frame.h"
+
+#include "podio/RNTupleReader.h"
+#include "podio/RNTupleWriter.h"
+
+int main(int, char**) {
+  auto options = podio::RNTupleWriter::Options{};
+  options.compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+  options.compressionLevel = 4;
+  options.approxZippedClusterSize = 1024 * 1024;
+  options.unzippedPageSize = 16 * 1024;
+  options.parallelCompression = true;
+  options.nThreads = 2;
+
+  {
+    podio::RNTupleWriter writer("example_rntuple_options.root", options);
+    write_frames(writer);
+  }
+
+  return read_frames<podio::RNTupleReader>("example_rntuple_options.root");
+}
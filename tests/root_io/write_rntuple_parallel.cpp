@@ -0,0 +1,34 @@
+#include "write_frame.h"
+
+#include "podio/RNTupleParallelWriter.h"
+
+#include <thread>
+#include <vector>
+
+int main(int, char**) {
+  constexpr int nThreads = 2;
+  podio::RNTupleParallelWriter parallelWriter("example_rntuple_parallel.root");
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads);
+  for (int iThread = 0; iThread < nThreads; ++iThread) {
+    threads.emplace_back([&parallelWriter, iThread]() {
+      auto writer = parallelWriter.getWriter();
+      for (int i = iThread; i < 10; i += nThreads) {
+        auto frame = makeFrame(i);
+        writer->writeFrame(frame, podio::Category::Event, collsToWrite);
+      }
+      for (int i = 100 + iThread; i < 110; i += nThreads) {
+        auto frame = makeFrame(i);
+        writer->writeFrame(frame, "other_events");
+      }
+      writer->finish();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  parallelWriter.finish();
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "read_frame.h"
+#include "write_frame.h"
+
+#include "podio/RNTupleParallelWriter.h"
+#include "podio/RNTupleReader.h"
+
+#include <ROOT/RNTupleReader.hxx>
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// The order of the frames depends on the order in which the clusters of the
+/// writers have been flushed, so get the event number from the contents
+int getEventNumber(const podio::Frame& frame) {
+  return static_cast<int>(frame.getParameter<float>("UserEventWeight").value() / 100.f);
+}
+
+int main(int, char**) {
+  constexpr int nThreads = 4;
+  constexpr int nEvents = 40;
+  const auto filename = std::string("example_rntuple_parallel_flush.root");
+
+  // Small clusters, such that all writers flush several of them to the file
+  // while the others are still filling
+  auto options = podio::RNTupleWriter::Options{};
+  options.approxZippedClusterSize = 16 * 1024;
+  options.unzippedPageSize = 4 * 1024;
+
+  {
+    podio::RNTupleParallelWriter parallelWriter(filename, options);
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (int iThread = 0; iThread < nThreads; ++iThread) {
+      threads.emplace_back([&parallelWriter, iThread]() {
+        // Alternate between the categories to fill both of them concurrently
+        auto writer = parallelWriter.getWriter();
+        for (int i = iThread; i < nEvents; i += nThreads) {
+          auto frame = makeFrame(i);
+          writer->writeFrame(frame, podio::Category::Event, collsToWrite);
+          auto otherFrame = makeFrame(100 + i);
+          writer->writeFrame(otherFrame, "other_events");
+        }
+        writer->finish();
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    parallelWriter.finish();
+  }
+
+  for (const auto category : {podio::Category::Event, "other_events"}) {
+    const auto nClusters = ROOT::Experimental::RNTupleReader::Open(category, filename)->GetDescriptor().GetNClusters();
+    if (nClusters <= nThreads) {
+      std::cerr << "Expected the writers to flush more than one cluster each for category " << category
+                << " (clusters: " << nClusters << ")" << std::endl;
+      return 1;
+    }
+  }
+
+  auto reader = podio::RNTupleReader();
+  reader.openFile(filename);
+  if (reader.getEntries(podio::Category::Event) != nEvents || reader.getEntries("other_events") != nEvents) {
+    std::cerr << "Could not read back the number of events correctly. (expected: " << nEvents
+              << ", actual: " << reader.getEntries(podio::Category::Event) << ", "
+              << reader.getEntries("other_events") << ")" << std::endl;
+    return 1;
+  }
+
+  std::set<int> events{};
+  std::set<int> otherEvents{};
+  for (size_t i = 0; i < reader.getEntries(podio::Category::Event); ++i) {
+    const auto frame = podio::Frame(reader.readNextEntry(podio::Category::Event));
+    const auto eventNumber = getEventNumber(frame);
+    processEvent(frame, eventNumber, reader.currentFileVersion());
+    events.insert(eventNumber);
+
+    const auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
+    const auto otherEventNumber = getEventNumber(otherFrame);
+    processEvent(otherFrame, otherEventNumber, reader.currentFileVersion());
+    processExtensions(otherFrame, otherEventNumber, reader.currentFileVersion());
+    otherEvents.insert(otherEventNumber);
+  }
+
+  if (events.size() != nEvents || *events.begin() != 0 || otherEvents.size() != nEvents ||
+      *otherEvents.begin() != 100) {
+    std::cerr << "Not all the frames that have been written in parallel could be read back" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
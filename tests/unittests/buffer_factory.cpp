@@ -150,3 +150,81 @@ TEST_CASE("construct CollectionData non-empty buffers", "[internals][memory-mana
     auto collData = ExampleWithVectorMemberCollectionData(std::move(buffers), false);
   }
 }
+
+TEST_CASE("Objs of read collections are created on access", "[internals][memory-management]") {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+  auto buffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+
+  auto dataBuffers = static_cast<ExampleHitDataContainer*>(buffers.data);
+  for (int i = 0; i < 10; ++i) {
+    dataBuffers->emplace_back(ExampleHitData{0xcaffee, 1.0, 2.0, 3.0, double(i)});
+  }
+
+  auto coll = buffers.createCollection(buffers, false);
+  coll->prepareAfterRead();
+  coll->setID(42);
+  auto& hits = static_cast<ExampleHitCollection&>(*coll);
+
+  // No need for any Objs to get the size or a single member for all elements
+  REQUIRE(hits.size() == 10);
+  const auto energies = hits.energy();
+  REQUIRE(energies.size() == 10);
+  REQUIRE(energies[9] == 9.0);
+  const auto& constHits = hits;
+  REQUIRE(constHits.xView().isStrided());
+  REQUIRE(constHits.xView()[3] == 1.0);
+
+  REQUIRE(constHits[3].energy() == 3.0);
+  REQUIRE(constHits[3].getObjectID() == podio::ObjectID{3, 42});
+  REQUIRE(hits.size() == 10);
+  REQUIRE(hits.energy(5).size() == 5);
+
+  // Creating new elements appends to the ones that have been read
+  auto hit = hits.create();
+  REQUIRE(hit.getObjectID().index == 10);
+  REQUIRE(hits.size() == 11);
+
+  hits.clear();
+  REQUIRE(hits.empty());
+}
+
+TEST_CASE("Writes through column views of read collections are written", "[internals][memory-management]") {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+  // Creates a collection from data as if it had been read
+  auto readCollection = [&factory](const ExampleHitDataContainer& data) {
+    auto buffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+    *static_cast<ExampleHitDataContainer*>(buffers.data) = data;
+    auto coll = buffers.createCollection(buffers, false);
+    coll->prepareAfterRead();
+    return coll;
+  };
+
+  auto data = ExampleHitDataContainer{};
+  for (int i = 0; i < 5; ++i) {
+    data.emplace_back(ExampleHitData{0xcaffee, 1.0, 2.0, 3.0, double(i)});
+  }
+  auto coll = readCollection(data);
+  auto& hits = static_cast<ExampleHitCollection&>(*coll);
+
+  SECTION("Before the Objs have been created") {
+    hits.energyView().assign(std::vector<double>{10., 11., 12., 13., 14.});
+  }
+
+  SECTION("After the Objs have been created") {
+    REQUIRE(hits[2].energy() == 2.0);
+    hits.energyView().assign(std::vector<double>{10., 11., 12., 13., 14.});
+    REQUIRE(hits[2].energy() == 12.0);
+  }
+
+  hits.prepareForWrite();
+  const auto* written = hits.getBuffers().dataAsVector<ExampleHitData>();
+  REQUIRE(written->size() == 5);
+
+  const auto readBack = readCollection(*written);
+  const auto& readHits = static_cast<const ExampleHitCollection&>(*readBack);
+  REQUIRE(readHits.size() == 5);
+  for (size_t i = 0; i < 5; ++i) {
+    REQUIRE(readHits[i].energy() == 10.0 + i);
+    REQUIRE(readHits[i].cellID() == 0xcaffee);
+  }
+}
@@ -1,7 +1,10 @@
+#include "podio/CollectionBufferFactory.h"
+#include "podio/CollectionBufferPool.h"
 #include "podio/Frame.h"
 
 #include "catch2/catch_test_macros.hpp"
 
+#include "datamodel/DatamodelDefinition.h"
 #include "datamodel/ExampleClusterCollection.h"
 #include "datamodel/ExampleHitCollection.h"
 
@@ -437,3 +440,214 @@ TEST_CASE("EIC-Jana2 cleanup use case", "[memory-management][492][174]") {
   }
   delete clone;
 }
+
+/// Minimal raw frame data that hands out pre-filled buffers
+struct BufferFrameData {
+  podio::CollectionIDTable idTable{};
+  std::map<std::string, podio::CollectionReadBuffers> buffers{};
+  std::shared_ptr<const podio::CollectionLayout> layout{nullptr};
+  std::shared_ptr<podio::CollectionBufferPool> pool{nullptr};
+
+  BufferFrameData() = default;
+  BufferFrameData(const BufferFrameData&) = delete;
+  BufferFrameData& operator=(const BufferFrameData&) = delete;
+
+  // Clean up the buffers that have not been handed out
+  ~BufferFrameData() {
+    for (auto& [_, buffer] : buffers) {
+      buffer.deleteBuffers(buffer);
+    }
+  }
+
+  std::shared_ptr<const podio::CollectionLayout> getCollectionLayout() const {
+    return layout;
+  }
+
+  void recycleCollection(const std::string& name, podio::CollectionBase& coll) {
+    if (pool) {
+      pool->put(name, coll.releaseBuffers());
+    }
+  }
+
+  podio::CollectionIDTable getIDTable() const {
+    return {idTable.ids(), idTable.names()};
+  }
+
+  std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name) {
+    const auto it = buffers.find(name);
+    if (it == buffers.end()) {
+      return std::nullopt;
+    }
+    auto buffer = it->second;
+    buffers.erase(it);
+    return buffer;
+  }
+
+  std::vector<std::string> getAvailableCollections() const {
+    std::vector<std::string> names;
+    for (const auto& [name, _] : buffers) {
+      names.push_back(name);
+    }
+    return names;
+  }
+
+  std::unique_ptr<podio::GenericParameters> getParameters() {
+    return std::make_unique<podio::GenericParameters>();
+  }
+};
+
+/// Raw data with hits and clusters where every cluster is related to two hits
+/// and to the previous cluster
+auto createBufferFrameData() {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+  auto frameData = std::make_unique<BufferFrameData>();
+  const auto hitsID = frameData->idTable.add("hits");
+  const auto clustersID = frameData->idTable.add("clusters");
+
+  auto hitBuffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+  for (int i = 0; i < 4; ++i) {
+    hitBuffers.dataAsVector<ExampleHitData>()->emplace_back(ExampleHitData{0x42ULL, 0., 0., 0., double(i)});
+  }
+  frameData->buffers.emplace("hits", hitBuffers);
+
+  auto clusterBuffers =
+      factory.createBuffers("ExampleClusterCollection", datamodel::meta::schemaVersion, false).value();
+  auto& hitRefs = *(*clusterBuffers.references)[0];
+  auto& clusterRefs = *(*clusterBuffers.references)[1];
+  for (unsigned i = 0; i < 3; ++i) {
+    const auto nClusterRefs = static_cast<unsigned>(clusterRefs.size());
+    clusterBuffers.dataAsVector<ExampleClusterData>()->emplace_back(
+        ExampleClusterData{double(i), 2 * i, 2 * i + 2, nClusterRefs, nClusterRefs + (i > 0)});
+    hitRefs.emplace_back(podio::ObjectID{static_cast<int>(i), hitsID});
+    hitRefs.emplace_back(podio::ObjectID{static_cast<int>(i + 1), hitsID});
+    if (i > 0) {
+      clusterRefs.emplace_back(podio::ObjectID{static_cast<int>(i - 1), clustersID});
+    }
+  }
+  frameData->buffers.emplace("clusters", clusterBuffers);
+
+  return frameData;
+}
+
+void checkBufferFrameRelations(const podio::Frame& frame) {
+  const auto& clusters = frame.get<ExampleClusterCollection>("clusters");
+  REQUIRE(clusters.size() == 3);
+  const auto& hits = frame.get<ExampleHitCollection>("hits");
+  REQUIRE(hits.size() == 4);
+
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    const auto cluster = clusters[i];
+    REQUIRE(cluster.Hits().size() == 2);
+    REQUIRE(cluster.Hits(0) == hits[i]);
+    REQUIRE(cluster.Hits(1) == hits[i + 1]);
+    if (i > 0) {
+      REQUIRE(cluster.Clusters(0) == clusters[i - 1]);
+    } else {
+      REQUIRE(cluster.Clusters().empty());
+    }
+  }
+}
+
+TEST_CASE("Frame relations from raw data", "[frame][basics]") {
+  const auto frame = podio::Frame(createBufferFrameData());
+  // The hits are retrieved while resolving the relations of the clusters
+  checkBufferFrameRelations(frame);
+}
+
+TEST_CASE("Frame prefetch", "[frame][basics][multithread]") {
+  SECTION("Selected collections") {
+    const auto frame = podio::Frame(createBufferFrameData());
+    frame.prefetch({"clusters", "hits", "non-existent"}, 2);
+    REQUIRE(frame.getAvailableCollections().size() == 2);
+    checkBufferFrameRelations(frame);
+  }
+
+  SECTION("Only the targets of relations") {
+    const auto frame = podio::Frame(createBufferFrameData());
+    frame.prefetch({"hits"});
+    checkBufferFrameRelations(frame);
+  }
+
+  SECTION("All collections") {
+    const auto frame = podio::Frame(createBufferFrameData());
+    frame.prefetchAll(4);
+    // Prefetching again does nothing
+    frame.prefetchAll();
+    checkBufferFrameRelations(frame);
+  }
+}
+
+TEST_CASE("Frame collection handles", "[frame][basics]") {
+  auto frameData = createBufferFrameData();
+  const auto layout = std::make_shared<const podio::CollectionLayout>(frameData->idTable);
+  frameData->layout = layout;
+  const auto frame = podio::Frame(std::move(frameData));
+
+  const auto hitsHandle = frame.getHandle<ExampleHitCollection>("hits");
+  REQUIRE(hitsHandle.isBound());
+  const auto clustersHandle = frame.getHandle<ExampleClusterCollection>("clusters");
+  REQUIRE(&frame.get(hitsHandle) == &frame.get<ExampleHitCollection>("hits"));
+  REQUIRE(frame.get(clustersHandle).size() == 3);
+  // Asking for the wrong type gives an empty collection
+  REQUIRE(frame.get(podio::CollectionHandle<ExampleClusterCollection>("hits")).empty());
+  REQUIRE(frame.get(frame.getHandle<ExampleClusterCollection>("hits")).empty());
+
+  SECTION("Frames with the same layout") {
+    auto otherData = createBufferFrameData();
+    otherData->layout = layout;
+    const auto otherFrame = podio::Frame(std::move(otherData));
+    // Getting via the handle unpacks the collection (and resolves its relations)
+    checkBufferFrameRelations(otherFrame);
+    REQUIRE(otherFrame.get(clustersHandle).size() == 3);
+    REQUIRE(&otherFrame.get(hitsHandle) == &otherFrame.get<ExampleHitCollection>("hits"));
+  }
+
+  SECTION("Frames with a different layout") {
+    const auto otherFrame = podio::Frame(createBufferFrameData());
+    REQUIRE(otherFrame.get(clustersHandle).size() == 3);
+    checkBufferFrameRelations(otherFrame);
+  }
+
+  SECTION("Collections that are not part of the layout") {
+    auto otherFrame = podio::Frame(createBufferFrameData());
+    otherFrame.put(ExampleHitCollection(), "moreHits");
+    const auto handle = otherFrame.getHandle<ExampleHitCollection>("moreHits");
+    REQUIRE_FALSE(handle.isBound());
+    REQUIRE(&otherFrame.get(handle) == &otherFrame.get<ExampleHitCollection>("moreHits"));
+  }
+}
+
+TEST_CASE("Frame buffer recycling", "[frame][memory-management]") {
+  auto pool = std::make_shared<podio::CollectionBufferPool>();
+  {
+    auto frameData = createBufferFrameData();
+    frameData->pool = pool;
+    const auto frame = podio::Frame(std::move(frameData));
+    checkBufferFrameRelations(frame);
+    REQUIRE(pool->size() == 0);
+  }
+  // The buffers of both collections are back in the pool
+  REQUIRE(pool->size() == 2);
+
+  const auto schemaVersion = datamodel::meta::schemaVersion;
+  // Only matching buffers are handed out
+  REQUIRE_FALSE(pool->take("hits", "ExampleClusterCollection", schemaVersion, false).has_value());
+  REQUIRE(pool->size() == 1);
+  REQUIRE_FALSE(pool->take("hits", "ExampleHitCollection", schemaVersion, false).has_value());
+
+  auto buffers = pool->take("clusters", "ExampleClusterCollection", schemaVersion, false);
+  REQUIRE(buffers.has_value());
+  REQUIRE(pool->size() == 0);
+  auto* data = buffers->dataAsVector<ExampleClusterData>();
+  REQUIRE(data->empty());
+  REQUIRE(data->capacity() >= 3);
+  REQUIRE(buffers->references->size() == 2);
+  REQUIRE((*buffers->references)[0]->empty());
+  REQUIRE((*buffers->references)[0]->capacity() >= 6);
+
+  // The buffers can be used to create a collection again
+  data->emplace_back(ExampleClusterData{42.0, 0, 0, 0, 0});
+  auto coll = buffers->createCollection(buffers.value(), false);
+  coll->prepareAfterRead();
+  REQUIRE(static_cast<ExampleClusterCollection&>(*coll)[0].energy() == 42.0);
+}
@@ -1,6 +1,7 @@
 // STL
 #include <cstdint>
 #include <filesystem>
+#include <limits>
 #include <map>
 #include <sstream>
 #include <stdexcept>
@@ -509,6 +510,146 @@ TEST_CASE("Collection size and empty", "[basics][collections]") {
   REQUIRE(coll.size() == 2u);
 }
 
+TEST_CASE("Collection storage with created and added objects", "[basics][collections][memory-management]") {
+  auto coll = ExampleHitCollection();
+  for (int i = 0; i < 100; ++i) {
+    coll.create(0x42ULL, double(i), 0., 0., 0.);
+    auto hit = MutableExampleHit();
+    hit.x(i);
+    coll.push_back(hit);
+  }
+  REQUIRE(coll.size() == 200);
+  for (size_t i = 0; i < coll.size(); ++i) {
+    REQUIRE(coll[i].x() == static_cast<double>(i / 2));
+    REQUIRE(coll[i].getObjectID().index == static_cast<int>(i));
+  }
+
+  coll.clear();
+  REQUIRE(coll.empty());
+
+  // Storage can be re-used after clearing
+  coll.create(0x42ULL, 1., 2., 3., 4.);
+  REQUIRE(coll.size() == 1);
+  REQUIRE(coll[0].energy() == 4.);
+}
+
+TEST_CASE("Column views", "[basics][collections]") {
+  auto coll = ExampleClusterCollection();
+  coll.create(1.);
+  coll.create(2.);
+  coll.create(3.);
+
+  // Objs created by the collection are in one block, so the view is strided
+  const auto& constColl = coll;
+  auto energies = constColl.energyView();
+  REQUIRE(energies.size() == 3);
+  REQUIRE(energies.isStrided());
+  REQUIRE(energies[1] == 2.);
+  REQUIRE(std::vector<double>(energies.begin(), energies.end()) == std::vector<double>{1., 2., 3.});
+
+  // Added objects break up the contiguous storage
+  auto cluster = MutableExampleCluster();
+  cluster.energy(4.);
+  coll.push_back(cluster);
+  energies = constColl.energyView();
+  REQUIRE_FALSE(energies.isStrided());
+  REQUIRE(energies.size() == 4);
+  REQUIRE(energies[3] == 4.);
+
+  // Bulk setting of values via a mutable view
+  coll.energyView().assign(std::vector<double>{5., 6., 7., 8.});
+  REQUIRE(coll[0].energy() == 5.);
+  REQUIRE(cluster.energy() == 8.);
+  REQUIRE_THROWS_AS(coll.energyView().assign(std::vector<double>{1.}), std::invalid_argument);
+
+  // The vectorized access goes through the views
+  REQUIRE(coll.energy(2) == std::vector<double>{5., 6.});
+
+  // Views of the members of other types work the same
+  auto hits = ExampleHitCollection();
+  hits.create(0x42ULL, 1., 2., 3., 4.);
+  hits.create(0x42ULL, 5., 6., 7., 8.);
+  const auto& constHits = hits;
+  const auto hitEnergies = constHits.energyView();
+  REQUIRE(hitEnergies.isStrided());
+  REQUIRE_FALSE(hitEnergies.isContiguous());
+  REQUIRE(hitEnergies[1] == 8.);
+  hits.xView()[0] = 42.;
+  REQUIRE(hits[0].x() == 42.);
+  REQUIRE(constHits.xView()[0] == 42.);
+}
+
+TEST_CASE("Batch operations", "[basics][collections]") {
+  auto hits = ExampleHitCollection();
+  for (int i = 0; i < 20; ++i) {
+    hits.create(0x42ULL + i, 0., 0., 0., double(i));
+  }
+  // Some that are not in the contiguous storage
+  auto hit = MutableExampleHit();
+  hit.energy(-1.);
+  hits.push_back(hit);
+
+  const auto& constHits = hits;
+  REQUIRE(constHits.energySum() == 189.);
+  REQUIRE(constHits.energyMin() == -1.);
+  REQUIRE(constHits.energyMax() == 19.);
+  REQUIRE(constHits.cellIDMax() == 0x42ULL + 19);
+  STATIC_REQUIRE(std::is_same_v<decltype(constHits.cellIDSum()), std::uint64_t>);
+
+  const auto highEnergy = constHits.energySelect([](double e) { return e > 15.; });
+  REQUIRE(highEnergy.isSubsetCollection());
+  REQUIRE(highEnergy.size() == 4);
+  REQUIRE(highEnergy[0] == hits[16]);
+
+  hits.energyTransform([](double e) { return 2 * e; });
+  REQUIRE(hits[10].energy() == 20.);
+  REQUIRE(hit.energy() == -2.);
+
+  // Also works for non-contiguous storage
+  auto clusters = ExampleClusterCollection();
+  for (int i = 0; i < 3; ++i) {
+    auto cluster = MutableExampleCluster();
+    cluster.energy(i);
+    clusters.push_back(cluster);
+  }
+  REQUIRE(clusters.energySum() == 3.);
+  REQUIRE(clusters.energyMax() == 2.);
+
+  // Reductions over empty collections yield the identity
+  REQUIRE(ExampleClusterCollection().energySum() == 0.);
+  REQUIRE(ExampleClusterCollection().energyMin() == std::numeric_limits<double>::max());
+}
+
+TEST_CASE("Lightweight views", "[basics][collections][relations]") {
+  auto hits = ExampleHitCollection();
+  auto clusters = ExampleClusterCollection();
+  auto cluster = clusters.create(0.);
+  for (int i = 0; i < 5; ++i) {
+    auto hit = hits.create(0x42ULL, 0., 0., 0., double(i));
+    cluster.addHits(hit);
+  }
+
+  double sum = 0;
+  for (const auto hit : hits.views()) {
+    STATIC_REQUIRE(std::is_same_v<decltype(hit), const ExampleHitView>);
+    sum += hit.energy();
+  }
+  REQUIRE(sum == 10.);
+  REQUIRE(hits.views().size() == 5);
+  REQUIRE(hits.views()[2].getObjectID() == hits[2].getObjectID());
+  REQUIRE(hits.views()[2].handle() == hits[2]);
+
+  // Views can be created from handles, e.g. while traversing relations
+  const auto clusterView = ExampleClusterView(cluster);
+  REQUIRE(clusterView.Hits_size() == 5);
+  for (const auto& hit : clusterView.Hits()) {
+    const ExampleHitView hitView = hit;
+    REQUIRE(hitView.energy() == hit.energy());
+  }
+
+  REQUIRE_FALSE(ExampleHitView().isAvailable());
+}
+
 TEST_CASE("const correct indexed access to const collections", "[const-correctness]") {
   STATIC_REQUIRE(std::is_same_v<decltype(std::declval<const ExampleClusterCollection>()[0]),
                                 ExampleCluster>); // const collections should only have indexed access to mutable
@@ -1112,6 +1253,36 @@ TEST_CASE("GenericParameters constructors", "[generic-parameters]") {
   }
 }
 
+TEST_CASE("GenericParameters getKeysAndValues into existing storage", "[generic-parameters]") {
+  auto params = podio::GenericParameters{};
+  params.set("ints", {1, 2, 3});
+  params.set("int", 42);
+
+  std::vector<std::string> keys;
+  std::vector<std::vector<int>> values;
+  params.getKeysAndValues(keys, values);
+  REQUIRE(keys.size() == 2);
+  REQUIRE(values.size() == 2);
+  const auto [expKeys, expValues] = params.getKeysAndValues<int>();
+  REQUIRE(keys == expKeys);
+  REQUIRE(values == expValues);
+
+  // Filling the same storage with fewer parameters drops the superfluous ones
+  // and does not allocate new vectors
+  const auto* valuesData = values.data();
+  auto otherParams = podio::GenericParameters{};
+  otherParams.set("single", 123);
+  otherParams.getKeysAndValues(keys, values);
+  REQUIRE(keys == std::vector<std::string>{"single"});
+  REQUIRE(values == std::vector<std::vector<int>>{{123}});
+  REQUIRE(values.data() == valuesData);
+
+  // Empty parameters give empty storage
+  podio::GenericParameters{}.getKeysAndValues(keys, values);
+  REQUIRE(keys.empty());
+  REQUIRE(values.empty());
+}
+
 TEST_CASE("Missing files (ROOT readers)", "[basics]") {
   auto root_legacy_reader = podio::ROOTLegacyReader();
   REQUIRE_THROWS_AS(root_legacy_reader.openFile("NonExistentFile.root"), std::runtime_error);
@@ -445,9 +445,7 @@ podio::Frame makeFrame(int iFrame) {
 }
 
 template <typename WriterT>
-void write_frames(const std::string& filename) {
-  WriterT writer(filename);
-
+void write_frames(WriterT& writer) {
   for (int i = 0; i < 10; ++i) {
     auto frame = makeFrame(i);
     writer.writeFrame(frame, podio::Category::Event, collsToWrite);
@@ -461,4 +459,10 @@ void write_frames(const std::string& filename) {
   writer.finish();
 }
 
+template <typename WriterT>
+void write_frames(const std::string& filename) {
+  WriterT writer(filename);
+  write_frames(writer);
+}
+
 #endif // PODIO_TESTS_WRITE_FRAME_H